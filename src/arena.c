@@ -0,0 +1,157 @@
+/** File: arena.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the arena allocator (see arena.h).
+  *
+  * The generators and the search need large scratch buffers whose size is
+  * only known when they start: the next level of a breadth first search, or
+  * the set of cubes a search has reached. Taking them from an arena that is
+  * reset between uses replaces a malloc and free (usually a fresh mmap, and
+  * a page fault for every page touched) with a pointer bump, and threads
+  * with their own arenas never wait on each other in the allocator.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+ArenaBlock* create_block(size_t size);
+size_t align_size(size_t size);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Arena Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates an empty arena. No memory is allocated until the
+  * first allocation.
+  * @param block_size The smallest block to allocate (larger allocations get
+  *    a block of their own size)
+  * @return Pointer to the arena
+  * @return NULL Out of memory
+  */
+Arena* create_arena(size_t block_size){
+  Arena* arena = (Arena*) malloc(sizeof(Arena));
+  if(arena == NULL) return NULL;
+  arena->blocks = NULL;
+  arena->block_size = align_size(block_size);
+  return arena;
+}
+
+/** This function frees an arena and every allocation made from it.
+  * @param arena The arena
+  */
+void free_arena(Arena* arena){
+  if(arena == NULL) return;
+  while(arena->blocks != NULL){
+    ArenaBlock* next = arena->blocks->next;
+    free(arena->blocks);
+    arena->blocks = next;
+  }
+  free(arena);
+}
+
+/** This function allocates memory from an arena. It is aligned on
+  * ARENA_ALIGN bytes and is valid until the arena is reset or freed.
+  * @param arena The arena
+  * @param size The number of bytes
+  * @return Pointer to the memory
+  * @return NULL Out of memory
+  */
+void* arena_alloc(Arena* arena, size_t size){
+  size = align_size(size);
+  ArenaBlock* block = arena->blocks;
+  if(block == NULL || block->size - block->used < size){
+    block = create_block((size > arena->block_size) ? size
+                                                    : arena->block_size);
+    if(block == NULL) return NULL;
+    block->next = arena->blocks;
+    arena->blocks = block;
+  }
+  void* memory = block->data + block->used;
+  block->used += size;
+  return memory;
+}
+
+/** This function allocates zeroed memory from an arena (see arena_alloc).
+  * @param arena The arena
+  * @param count The number of elements
+  * @param size The size of each element
+  * @return Pointer to the memory
+  * @return NULL Out of memory
+  */
+void* arena_calloc(Arena* arena, size_t count, size_t size){
+  if(size != 0 && count > ((size_t) -1) / size) return NULL;
+  void* memory = arena_alloc(arena, count * size);
+  if(memory != NULL) memset(memory, 0, count * size);
+  return memory;
+}
+
+/** This function releases every allocation made from an arena. The largest
+  * block is kept for the allocations that follow and the others are freed.
+  * @param arena The arena
+  */
+void arena_reset(Arena* arena){
+  ArenaBlock* largest = arena->blocks;
+  ArenaBlock* block;
+  for(block = arena->blocks; block != NULL; block = block->next){
+    if(block->size > largest->size) largest = block;
+  }
+  block = arena->blocks;
+  while(block != NULL){
+    ArenaBlock* next = block->next;
+    if(block != largest) free(block);
+    block = next;
+  }
+  arena->blocks = largest;
+  if(largest != NULL){
+    largest->next = NULL;
+    largest->used = 0;
+  }
+}
+
+/** This function returns the memory an arena is holding
+  * @param arena The arena
+  * @return The number of bytes in its blocks
+  */
+size_t arena_capacity(const Arena* arena){
+  size_t capacity = 0;
+  const ArenaBlock* block;
+  for(block = arena->blocks; block != NULL; block = block->next){
+    capacity += block->size;
+  }
+  return capacity;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function allocates a block
+  * @param size The bytes of data in the block (a multiple of ARENA_ALIGN)
+  * @return Pointer to the empty block
+  * @return NULL Out of memory
+  */
+ArenaBlock* create_block(size_t size){
+  ArenaBlock* block = (ArenaBlock*) aligned_alloc(ARENA_ALIGN,
+                                                  sizeof(ArenaBlock) + size);
+  if(block == NULL) return NULL;
+  block->next = NULL;
+  block->size = size;
+  block->used = 0;
+  return block;
+}
+
+/** This function rounds a size up to a multiple of ARENA_ALIGN
+  * @param size The size
+  * @return The rounded size
+  */
+size_t align_size(size_t size){
+  return (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+}
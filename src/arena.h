@@ -0,0 +1,42 @@
+/** File: arena.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the arena structure and the function prototypes for
+  * the file arena.c
+  */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_ALIGN 64 //every allocation starts on its own cache line
+
+//one block of memory that allocations are carved from
+typedef struct ArenaBlock {
+  struct ArenaBlock* next;      //the block allocated before this one
+  size_t size;                  //bytes of data
+  size_t used;                  //bytes of data handed out
+  _Alignas(ARENA_ALIGN) unsigned char data[];
+} ArenaBlock;
+
+/** A bump allocator. Allocations are carved from large blocks and are never
+  * freed one at a time: resetting the arena releases all of them at once and
+  * keeps its largest block, so an arena that is reset between uses stops
+  * calling malloc once it has grown to the size it needs. An arena must only
+  * be used by one thread at a time.
+  */
+typedef struct Arena {
+  ArenaBlock* blocks;           //the block being carved, then older blocks
+  size_t block_size;            //the smallest block allocated
+} Arena;
+
+//Function Prototypes
+Arena* create_arena(size_t block_size);
+void free_arena(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+void arena_reset(Arena* arena);
+size_t arena_capacity(const Arena* arena);
+
+#endif
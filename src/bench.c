@@ -0,0 +1,780 @@
+/** File: bench.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the benchmark harness for the solver (make bench).
+  *
+  * Every measurement is written to stdout as one line:
+  *   BENCH <name> <value> <unit>
+  * followed by the line BENCH END, so that runs can be compared by a script.
+  * The random cubes come from a fixed seed, so every run does the same work.
+  * Usage: benchmark [name prefix]  (only run the benchmarks that match)
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "cube.h"
+#include "state_table.h"
+#include "table_file.h"
+#include "depth_table.h"
+#include "parallel_table.h"
+#include "symmetry_table.h"
+#include "packed_cube.h"
+#include "parse.h"
+#include "solution_cache.h"
+#include "search.h"
+#include "sorted_index.h"
+#include "queue.h"
+
+#define ROTATIONS 10000000 //turns timed per move type
+#define LOOKUPS 2000000 //lookups timed per access pattern
+#define BENCH_SEED 0x2B2B2B2Bu //seed of the random cubes
+#define MOVE_BATCH 4096 //cubes turned per call to rotate_batch
+#define HOT_CUBES 4096 //distinct cubes asked for by the cached solve
+#define SEARCHES 1000 //cubes solved by search (no table)
+#define QUEUE_ENTRIES 4000000 //entries passed through each queue
+#define QUEUE_BLOCK 256 //entries per call to the bulk queue functions
+
+static const char* rotation_names[6] = {"frontCC", "frontC", "leftCC",
+                                        "leftC", "topCC", "topC"};
+static const char* filter; //only run benchmarks starting with this
+static volatile int sink; //keeps results from being optimized away
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void bench_generate(unsigned char* state_table, uint64_t* ranked_table);
+void bench_rotate();
+void bench_rank(unsigned char* state_table);
+void bench_parse(unsigned char* state_table);
+void bench_get_turn(unsigned char* state_table, const uint64_t* ranked_table);
+void bench_solve(unsigned char* state_table, const uint64_t* ranked_table);
+void bench_format(unsigned char* state_table, const uint64_t* ranked_table);
+void bench_load(unsigned char* state_table, const uint64_t* ranked_table);
+void bench_queue();
+void* spsc_producer(void* arg);
+int selected(const char* name);
+void report(const char* name, double value, const char* unit);
+double now_seconds();
+uint32_t next_random(uint32_t* state);
+int cube_at(const unsigned char* state_table, int index);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~ Benchmark Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+int main(int argc, char** argv){
+  filter = (argc > 1) ? argv[1] : "";
+
+  unsigned char* state_table = make_state_table();
+  uint64_t* ranked_table = make_ranked_table();
+  if(state_table == NULL || ranked_table == NULL){
+    printf("Could not allocate the state tables.\n");
+    return 1;
+  }
+
+  bench_generate(state_table, ranked_table); //the tables the rest use
+  bench_rotate();
+  bench_rank(state_table);
+  bench_parse(state_table);
+  bench_get_turn(state_table, ranked_table);
+  bench_solve(state_table, ranked_table);
+  bench_format(state_table, ranked_table);
+  bench_load(state_table, ranked_table);
+  bench_queue();
+  printf("BENCH END\n");
+
+  free(state_table);
+  free(ranked_table);
+  return 0;
+}
+
+/** This function times the table generators. The sorted and ranked tables
+  * are always filled, since every other benchmark needs them.
+  * @param state_table Filled with the sorted state table
+  * @param ranked_table Filled with the ranked table
+  */
+void bench_generate(unsigned char* state_table, uint64_t* ranked_table){
+  double start = now_seconds();
+  if(!fill_state_table(state_table)){
+    printf("The state table could not be generated.\n");
+    exit(1);
+  }
+  report("fill_state_table", now_seconds() - start, "s");
+
+  start = now_seconds();
+  generate_ranked_table(ranked_table);
+  report("generate_ranked_table", now_seconds() - start, "s");
+
+  if(selected("generate_ranked_table_parallel")){
+    uint64_t* parallel_table = make_ranked_table();
+    start = now_seconds();
+    generate_ranked_table_parallel(parallel_table, 4);
+    report("generate_ranked_table_parallel", now_seconds() - start, "s");
+    free(parallel_table);
+  }
+
+  if(selected("generate_depth_table")){
+    uint8_t* depth_table = make_depth_table();
+    start = now_seconds();
+    generate_depth_table(depth_table);
+    report("generate_depth_table", now_seconds() - start, "s");
+    free(depth_table);
+  }
+}
+
+/** This function times each move type, on the cube int (rotate) and on rank
+  * coordinates (rotate_rank), one at a time and in batches.
+  */
+void bench_rotate(){
+  static int batch[MOVE_BATCH];
+  char name[64];
+  int turn;
+  for(turn = 0; turn < 6; turn++){
+    sprintf(name, "rotate_batch.%s", rotation_names[turn]);
+    if(selected(name)){
+      int i;
+      for(i = 0; i < MOVE_BATCH; i++) batch[i] = unrank_cube(i * 797);
+      double start = now_seconds();
+      for(i = 0; i < ROTATIONS / MOVE_BATCH; i++){
+        rotate_batch(batch, MOVE_BATCH, turn);
+      }
+      report(name, (now_seconds() - start) * 1e9 / 
+                   ((ROTATIONS / MOVE_BATCH) * MOVE_BATCH), "ns/op");
+      sink = batch[0];
+    }
+
+    sprintf(name, "rotate_rank_batch.%s", rotation_names[turn]);
+    if(selected(name)){
+      int i;
+      for(i = 0; i < MOVE_BATCH; i++) batch[i] = i * 797;
+      double start = now_seconds();
+      for(i = 0; i < ROTATIONS / MOVE_BATCH; i++){
+        rotate_rank_batch(batch, MOVE_BATCH, turn);
+      }
+      report(name, (now_seconds() - start) * 1e9 / 
+                   ((ROTATIONS / MOVE_BATCH) * MOVE_BATCH), "ns/op");
+      sink = batch[0];
+    }
+
+    sprintf(name, "rotate.%s", rotation_names[turn]);
+    if(selected(name)){
+      int cube = SOLVED_CUBE;
+      double start = now_seconds();
+      int i;
+      for(i = 0; i < ROTATIONS; i++){
+        cube = rotate(cube, turn);
+      }
+      report(name, (now_seconds() - start) * 1e9 / ROTATIONS, "ns/op");
+      sink = cube;
+    }
+
+    sprintf(name, "rotate_packed.%s", rotation_names[turn]);
+    if(selected(name) && init_packed_moves()){
+      PackedCube packed = pack_cube(SOLVED_CUBE);
+      double start = now_seconds();
+      int i;
+      for(i = 0; i < ROTATIONS; i++){
+        packed = rotate_packed(packed, turn);
+      }
+      report(name, (now_seconds() - start) * 1e9 / ROTATIONS, "ns/op");
+      sink = (int) packed;
+    }
+
+    sprintf(name, "rotate_rank.%s", rotation_names[turn]);
+    if(selected(name)){
+      int rank = rank_cube(SOLVED_CUBE);
+      double start = now_seconds();
+      int i;
+      for(i = 0; i < ROTATIONS; i++){
+        rank = rotate_rank(rank, turn);
+      }
+      report(name, (now_seconds() - start) * 1e9 / ROTATIONS, "ns/op");
+      sink = rank;
+    }
+  }
+}
+
+/** This function times ranking a cube, from the integer representation and
+  * from the packed representation.
+  * @param state_table The sorted state table (the cubes to rank)
+  */
+void bench_rank(unsigned char* state_table){
+  if(selected("rank_cube")){
+    int total = 0;
+    double start = now_seconds();
+    int i;
+    for(i = 0; i < NUMBER_OF_CUBES; i++){
+      total += rank_cube(cube_at(state_table, i));
+    }
+    report("rank_cube", (now_seconds() - start) * 1e9 / NUMBER_OF_CUBES,
+           "ns/op");
+    sink = total;
+  }
+
+  if(selected("rank_packed")){
+    PackedCube* packed = (PackedCube*) malloc(NUMBER_OF_CUBES * 
+                                              sizeof(PackedCube));
+    if(packed == NULL) return;
+    int i;
+    for(i = 0; i < NUMBER_OF_CUBES; i++){
+      packed[i] = pack_cube(cube_at(state_table, i));
+    }
+    int total = 0;
+    double start = now_seconds();
+    for(i = 0; i < NUMBER_OF_CUBES; i++){
+      total += rank_packed(packed[i]);
+    }
+    report("rank_packed", (now_seconds() - start) * 1e9 / NUMBER_OF_CUBES,
+           "ns/op");
+    sink = total;
+    free(packed);
+  }
+}
+
+/** This function times converting the 24 colors of a cube into a cube 
+  * (compress), for every cube.
+  * @param state_table The sorted state table (the cubes to convert)
+  */
+void bench_parse(unsigned char* state_table){
+  if(!selected("compress")) return;
+  //the buffer index of each row and column of the Cube struct
+  static const char faces[BUFF_SIZE][2] = {
+    {0,2}, {0,3}, {1,2}, {1,3}, {2,0}, {2,1}, {3,0}, {3,1}, {2,2}, {2,3},
+    {3,2}, {3,3}, {2,4}, {2,5}, {3,4}, {3,5}, {2,6}, {2,7}, {3,6}, {3,7},
+    {4,2}, {4,3}, {5,2}, {5,3}};
+  char* buffers = (char*) malloc((size_t) NUMBER_OF_CUBES * BUFF_SIZE);
+  if(buffers == NULL) return;
+  int i, j;
+  for(i = 0; i < NUMBER_OF_CUBES; i++){
+    Cube cube;
+    decompress_into(cube_at(state_table, i), &cube);
+    for(j = 0; j < BUFF_SIZE; j++){
+      buffers[(i * BUFF_SIZE) + j] = cube.cube[(int) faces[j][0]]
+                                              [(int) faces[j][1]];
+    }
+  }
+
+  int total = 0;
+  double start = now_seconds();
+  for(i = 0; i < NUMBER_OF_CUBES; i++){
+    total += compress(&buffers[i * BUFF_SIZE]);
+  }
+  report("compress", (now_seconds() - start) * 1e9 / NUMBER_OF_CUBES, "ns/op");
+  sink = total;
+  free(buffers);
+}
+
+/** This function times single turn lookups, in random order and in table
+  * order, on the sorted, ranked and symmetry tables, and on the index of the
+  * sorted table. The lookups on the sorted table are also timed in batches.
+  * @param state_table The sorted state table
+  * @param ranked_table The ranked table
+  */
+void bench_get_turn(unsigned char* state_table, const uint64_t* ranked_table){
+  int* random_cubes = (int*) malloc(LOOKUPS * sizeof(int));
+  int* sequential_cubes = (int*) malloc(LOOKUPS * sizeof(int));
+  if(random_cubes == NULL || sequential_cubes == NULL){
+    free(random_cubes);
+    free(sequential_cubes);
+    return;
+  }
+  uint32_t seed = BENCH_SEED;
+  int i;
+  for(i = 0; i < LOOKUPS; i++){
+    random_cubes[i] = cube_at(state_table,
+                              next_random(&seed) % NUMBER_OF_CUBES);
+    sequential_cubes[i] = cube_at(state_table, i % NUMBER_OF_CUBES);
+  }
+
+  const char* orders[2] = {"random", "sequential"};
+  int* cubes[2] = {random_cubes, sequential_cubes};
+  uint64_t* symmetry_table = make_symmetry_table();
+  if(symmetry_table != NULL && !reduce_ranked_table(ranked_table, 
+                                                    symmetry_table)){
+    free(symmetry_table);
+    symmetry_table = NULL;
+  }
+  SortedIndex* index = build_sorted_index(state_table);
+  static char turns[MOVE_BATCH];
+  char name[64];
+  int order;
+  for(order = 0; order < 2; order++){
+    sprintf(name, "get_turn.%s", orders[order]);
+    if(selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i < LOOKUPS; i++){
+        total += get_turn(state_table, cubes[order][i]);
+      }
+      report(name, (now_seconds() - start) * 1e9 / LOOKUPS, "ns/lookup");
+      sink = total;
+    }
+
+    sprintf(name, "get_turn_batch.%s", orders[order]);
+    if(selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i + MOVE_BATCH <= LOOKUPS; i += MOVE_BATCH){
+        get_turn_batch(state_table, &cubes[order][i], MOVE_BATCH, turns);
+        total += turns[0];
+      }
+      report(name, (now_seconds() - start) * 1e9 / i, "ns/lookup");
+      sink = total;
+    }
+
+    sprintf(name, "get_indexed_turn.%s", orders[order]);
+    if(index != NULL && selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i < LOOKUPS; i++){
+        total += get_indexed_turn(index, cubes[order][i]);
+      }
+      report(name, (now_seconds() - start) * 1e9 / LOOKUPS, "ns/lookup");
+      sink = total;
+    }
+
+    sprintf(name, "get_indexed_turn_batch.%s", orders[order]);
+    if(index != NULL && selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i + MOVE_BATCH <= LOOKUPS; i += MOVE_BATCH){
+        get_indexed_turn_batch(index, &cubes[order][i], MOVE_BATCH, turns);
+        total += turns[0];
+      }
+      report(name, (now_seconds() - start) * 1e9 / i, "ns/lookup");
+      sink = total;
+    }
+
+    sprintf(name, "get_ranked_turn.%s", orders[order]);
+    if(selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i < LOOKUPS; i++){
+        total += get_ranked_turn(ranked_table, cubes[order][i]);
+      }
+      report(name, (now_seconds() - start) * 1e9 / LOOKUPS, "ns/lookup");
+      sink = total;
+    }
+
+    sprintf(name, "get_symmetry_turn.%s", orders[order]);
+    if(symmetry_table != NULL && selected(name)){
+      int total = 0;
+      double start = now_seconds();
+      for(i = 0; i < LOOKUPS; i++){
+        total += get_symmetry_turn(symmetry_table, cubes[order][i]);
+      }
+      report(name, (now_seconds() - start) * 1e9 / LOOKUPS, "ns/lookup");
+      sink = total;
+    }
+  }
+  free_sorted_index(index);
+  free(symmetry_table);
+  free(random_cubes);
+  free(sequential_cubes);
+}
+
+/** This function times solving every one of the 3,674,160 cubes, on the
+  * sorted and ranked tables (and in batches on the sorted table, with and
+  * without its index), solving random cubes by search (bidirectional
+  * and IDA*, no table), and solving a few thousand hot cubes over and over
+  * through the solution cache.
+  * @param state_table The sorted state table
+  * @param ranked_table The ranked table
+  */
+void bench_solve(unsigned char* state_table, const uint64_t* ranked_table){
+  char turn_sequence[SOLUTION_SIZE];
+  int i;
+  if(selected("solve_cube")){
+    int total = 0;
+    double start = now_seconds();
+    for(i = 0; i < NUMBER_OF_CUBES; i++){
+      total += solve_cube_into(cube_at(state_table, i), state_table,
+                               turn_sequence);
+    }
+    report("solve_cube", NUMBER_OF_CUBES / (now_seconds() - start),
+           "solves/s");
+    sink = total;
+  }
+
+  if(selected("solve_ranked_cube")){
+    int total = 0;
+    double start = now_seconds();
+    for(i = 0; i < NUMBER_OF_CUBES; i++){
+      total += solve_ranked_cube_into(cube_at(state_table, i), ranked_table,
+                                      turn_sequence);
+    }
+    report("solve_ranked_cube", NUMBER_OF_CUBES / (now_seconds() - start),
+           "solves/s");
+    sink = total;
+  }
+
+  const char* batch_names[2] = {"solve_sorted_batch", "solve_indexed_batch"};
+  int indexed;
+  for(indexed = 0; indexed < 2; indexed++){
+    if(!selected(batch_names[indexed])) continue;
+    static int cubes[MOVE_BATCH];
+    static char solutions[MOVE_BATCH * SOLUTION_SIZE];
+    SortedIndex* index = indexed ? build_sorted_index(state_table) : NULL;
+    if(indexed && index == NULL) continue;
+    size_t total = 0;
+    double start = now_seconds();
+    for(i = 0; i < NUMBER_OF_CUBES; i += MOVE_BATCH){
+      int count = (NUMBER_OF_CUBES - i < MOVE_BATCH) ? NUMBER_OF_CUBES - i
+                                                     : MOVE_BATCH;
+      int j;
+      for(j = 0; j < count; j++) cubes[j] = cube_at(state_table, i + j);
+      total += solve_sorted_batch(cubes, count, state_table, index,
+                                  solutions);
+    }
+    report(batch_names[indexed], NUMBER_OF_CUBES / (now_seconds() - start),
+           "solves/s");
+    sink = (int) total;
+    free_sorted_index(index);
+  }
+
+  if(selected("search_solve")){
+    uint32_t seed = BENCH_SEED;
+    int total = 0;
+    double start = now_seconds();
+    for(i = 0; i < SEARCHES; i++){
+      total += search_solve_cube_into(cube_at(state_table, next_random(&seed) %
+                                              NUMBER_OF_CUBES), turn_sequence);
+    }
+    report("search_solve", SEARCHES / (now_seconds() - start), "solves/s");
+    sink = total;
+  }
+
+  if(selected("ida_solve")){
+    uint32_t seed = BENCH_SEED;
+    int total = 0;
+    init_distance_tables();
+    double start = now_seconds();
+    for(i = 0; i < SEARCHES; i++){
+      total += ida_solve_cube_into(cube_at(state_table, next_random(&seed) %
+                                           NUMBER_OF_CUBES), turn_sequence);
+    }
+    report("ida_solve", SEARCHES / (now_seconds() - start), "solves/s");
+    sink = total;
+  }
+
+  SolutionCache* cache = create_solution_cache(DEFAULT_CACHE_SLOTS);
+  if(cache != NULL && selected("solve_cached.hot")){
+    StateTable table = {TABLE_RANKED, ranked_table, 0, NULL, 0, NULL};
+    int hot[HOT_CUBES];
+    uint32_t seed = BENCH_SEED;
+    for(i = 0; i < HOT_CUBES; i++){
+      hot[i] = cube_at(state_table, next_random(&seed) % NUMBER_OF_CUBES);
+    }
+    int total = 0;
+    double start = now_seconds();
+    for(i = 0; i < LOOKUPS; i++){
+      total += cache_solve_cube_into(cache, &table,
+                                     hot[next_random(&seed) % HOT_CUBES],
+                                     turn_sequence);
+    }
+    report("solve_cached.hot", LOOKUPS / (now_seconds() - start), "solves/s");
+    unsigned long long hits, misses;
+    cache_counts(cache, &hits, &misses);
+    report("solve_cached.hot_hit_rate", (double) hits / (hits + misses),
+           "ratio");
+    sink = total;
+  }
+  free_solution_cache(cache);
+}
+
+/** This function times writing solutions as text: the turn sequences as
+  * FCC FC... (format_solution), and packed solutions in the standard
+  * notation (format_packed_solution). It also times the packed batch solve.
+  * @param state_table The sorted state table
+  * @param ranked_table The ranked table
+  */
+void bench_format(unsigned char* state_table, const uint64_t* ranked_table){
+  int* cubes = (int*) malloc(MOVE_BATCH * sizeof(int));
+  char* solutions = (char*) malloc(MOVE_BATCH * SOLUTION_SIZE);
+  PackedSolution* packed = (PackedSolution*) malloc(MOVE_BATCH *
+                                                    sizeof(PackedSolution));
+  char* out = (char*) malloc(MOVE_BATCH * OUTPUT_LINE_SIZE);
+  if(cubes == NULL || solutions == NULL || packed == NULL || out == NULL){
+    free(cubes);
+    free(solutions);
+    free(packed);
+    free(out);
+    return;
+  }
+  StateTable table = {TABLE_RANKED, ranked_table, 0, NULL, 0, NULL};
+  uint32_t seed = BENCH_SEED;
+  int i;
+  for(i = 0; i < MOVE_BATCH; i++){
+    cubes[i] = cube_at(state_table, next_random(&seed) % NUMBER_OF_CUBES);
+  }
+  solve_batch(cubes, MOVE_BATCH, &table, solutions);
+  int rounds = LOOKUPS / MOVE_BATCH;
+
+  if(selected("format.solution")){
+    size_t bytes = 0;
+    double start = now_seconds();
+    int round;
+    for(round = 0; round < rounds; round++){
+      char* end = out;
+      for(i = 0; i < MOVE_BATCH; i++){
+        end = format_solution(end, &solutions[i * SOLUTION_SIZE]);
+      }
+      bytes += end - out;
+    }
+    report("format.solution", (now_seconds() - start) * 1e9 /
+           (rounds * MOVE_BATCH), "ns/solution");
+    report("format.solution_bytes", (double) bytes / (rounds * MOVE_BATCH),
+           "bytes/solution");
+  }
+
+  if(selected("format.packed_solution")){
+    for(i = 0; i < MOVE_BATCH; i++){
+      packed[i] = pack_solution(&solutions[i * SOLUTION_SIZE]);
+    }
+    size_t bytes = 0;
+    double start = now_seconds();
+    int round;
+    for(round = 0; round < rounds; round++){
+      char* end = out;
+      for(i = 0; i < MOVE_BATCH; i++){
+        end = format_packed_solution(end, packed[i]);
+      }
+      bytes += end - out;
+    }
+    report("format.packed_solution", (now_seconds() - start) * 1e9 /
+           (rounds * MOVE_BATCH), "ns/solution");
+    report("format.packed_solution_bytes",
+           (double) bytes / (rounds * MOVE_BATCH), "bytes/solution");
+  }
+
+  if(selected("solve_batch_packed")){
+    double start = now_seconds();
+    int round;
+    for(round = 0; round < rounds; round++){
+      solve_batch_packed(cubes, MOVE_BATCH, &table, packed);
+    }
+    report("solve_batch_packed", (rounds * MOVE_BATCH) /
+           (now_seconds() - start), "solves/s");
+  }
+  free(cubes);
+  free(solutions);
+  free(packed);
+  free(out);
+}
+
+/** This function times loading the tables: the headerless fread of the
+  * original state_table.bin, mapping a table file, building
+  * the index of the sorted table, and decoding a mod 3 table into a ranked
+  * table.
+  * The tables are written to bench_*.bin first and removed afterwards.
+  * @param state_table The sorted state table
+  * @param ranked_table The ranked table
+  */
+void bench_load(unsigned char* state_table, const uint64_t* ranked_table){
+  if(selected("load.read_state_table")){
+    FILE* file = fopen("state_table.bin", "rb");
+    if(file != NULL){
+      fclose(file);
+      unsigned char* read_table = make_state_table();
+      double start = now_seconds();
+      read_state_table(read_table);
+      report("load.read_state_table", now_seconds() - start, "s");
+      free(read_table);
+    }
+  }
+
+  const char* names[2] = {"load.open_sorted_table", "load.open_ranked_table"};
+  const char* files[2] = {"bench_state_table.bin", "bench_ranked_table.bin"};
+  const int encodings[2] = {TABLE_SORTED, TABLE_RANKED};
+  const void* data[2] = {state_table, ranked_table};
+  const size_t sizes[2] = {NUMBER_OF_CUBES * SIZE_OF_CUBE,
+                           RANKED_TABLE_WORDS * sizeof(uint64_t)};
+  int i;
+  for(i = 0; i < 2; i++){
+    if(!selected(names[i]) ||
+       !save_state_table(files[i], encodings[i], data[i], sizes[i])) continue;
+    double start = now_seconds();
+    StateTable* table = open_state_table(files[i], 0);
+    double seconds = now_seconds() - start;
+    if(table != NULL){
+      report(names[i], seconds, "s");
+      close_state_table(table);
+    }
+    remove(files[i]);
+  }
+
+  if(selected("load.build_sorted_index")){
+    double start = now_seconds();
+    SortedIndex* index = build_sorted_index(state_table);
+    if(index != NULL){
+      report("load.build_sorted_index", now_seconds() - start, "s");
+      free_sorted_index(index);
+    }
+  }
+
+  if(selected("load.decode_mod3_table")){
+    uint8_t* depth_table = make_depth_table();
+    uint8_t* mod3_table = make_mod3_table();
+    uint64_t* decoded_table = make_ranked_table();
+    if(depth_table != NULL && mod3_table != NULL && decoded_table != NULL &&
+       generate_depth_table(depth_table) &&
+       reduce_depth_table(depth_table, mod3_table)){
+      double start = now_seconds();
+      if(decode_mod3_table(mod3_table, decoded_table)){
+        report("load.decode_mod3_table", now_seconds() - start, "s");
+      }
+    }
+    free(depth_table);
+    free(mod3_table);
+    free(decoded_table);
+  }
+}
+
+/** This function times the 64 bit queues: a Queue64 filled and emptied one
+  * entry at a time and a block at a time, and a SPSCQueue64 passing entries
+  * from a producer thread to this thread.
+  */
+void bench_queue(){
+  static uint64_t block[QUEUE_BLOCK];
+  if(selected("queue.queue64")){
+    Queue64* queue = createQueue64(0);
+    if(queue != NULL){
+      uint64_t sum = 0;
+      uint64_t i, entry;
+      double start = now_seconds();
+      for(i = 0; i < QUEUE_ENTRIES; i++) enqueue64(queue, i);
+      while(dequeue64(queue, &entry) == QUEUE_OK) sum += entry;
+      report("queue.queue64", QUEUE_ENTRIES / (now_seconds() - start),
+             "entries/s");
+
+      start = now_seconds();
+      for(i = 0; i < QUEUE_ENTRIES; i += QUEUE_BLOCK){
+        size_t j;
+        for(j = 0; j < QUEUE_BLOCK; j++) block[j] = i + j;
+        enqueue64_n(queue, block, QUEUE_BLOCK);
+      }
+      size_t size;
+      while((size = dequeue64_n(queue, block, QUEUE_BLOCK)) > 0){
+        sum += block[size - 1];
+      }
+      report("queue.queue64_n", QUEUE_ENTRIES / (now_seconds() - start),
+             "entries/s");
+      sink = (int) sum;
+      deleteQueue64(queue);
+    }
+  }
+
+  if(selected("queue.spsc")){
+    SPSCQueue64* queue = createSPSCQueue64(65536);
+    pthread_t producer;
+    if(queue != NULL &&
+       pthread_create(&producer, NULL, spsc_producer, queue) == 0){
+      uint64_t received = 0;
+      uint64_t sum = 0;
+      double start = now_seconds();
+      while(received < QUEUE_ENTRIES){
+        size_t size = spsc_dequeue64_n(queue, block, QUEUE_BLOCK);
+        if(size == 0) sched_yield();
+        size_t j;
+        for(j = 0; j < size; j++) sum += block[j];
+        received += size;
+      }
+      pthread_join(producer, NULL);
+      report("queue.spsc", QUEUE_ENTRIES / (now_seconds() - start),
+             "entries/s");
+      if(sum != ((uint64_t) QUEUE_ENTRIES * (QUEUE_ENTRIES - 1)) / 2)
+        printf("The SPSC queue lost entries.\n");
+      sink = (int) sum;
+    }
+    if(queue != NULL) deleteSPSCQueue64(queue);
+  }
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function checks whether a benchmark was selected on the command line
+  * @param name The name of the benchmark
+  * @return 1 The benchmark should run
+  * @return 0 The benchmark should be skipped
+  */
+int selected(const char* name){
+  return strncmp(name, filter, strlen(filter)) == 0;
+}
+
+/** This function writes one measurement
+  * @param name The name of the benchmark
+  * @param value The measured value
+  * @param unit The unit of the value
+  */
+void report(const char* name, double value, const char* unit){
+  printf("BENCH %s %.6g %s\n", name, value, unit);
+  fflush(stdout);
+}
+
+/** This function reads the monotonic clock
+  * @return The time in seconds
+  */
+double now_seconds(){
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + (now.tv_nsec / 1e9);
+}
+
+/** This function returns the next number of a xorshift generator, so the
+  * random cubes are the same on every run
+  * @param state The state of the generator (not 0)
+  * @return The next random number
+  */
+uint32_t next_random(uint32_t* state){
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/** This function reads the cube stored at an index of the sorted state table
+  * @param state_table The sorted state table
+  * @param index The index of the cube
+  * @return The cube
+  */
+int cube_at(const unsigned char* state_table, int index){
+  const unsigned char* entry = &state_table[index * SIZE_OF_CUBE];
+  return (((int) entry[0]) << 24) | (((int) entry[1]) << 16) |
+         (((int) entry[2]) << 8) | ((int) entry[3]);
+}
+
+/** This function is the producer thread of the SPSC queue benchmark: it
+  * enqueues the numbers 0 to QUEUE_ENTRIES - 1 a block at a time.
+  * @param arg The SPSCQueue64
+  * @return NULL
+  */
+void* spsc_producer(void* arg){
+  SPSCQueue64* queue = (SPSCQueue64*) arg;
+  uint64_t block[QUEUE_BLOCK];
+  uint64_t next = 0;
+  while(next < QUEUE_ENTRIES){
+    size_t j;
+    for(j = 0; j < QUEUE_BLOCK; j++) block[j] = next + j;
+    size_t sent = 0;
+    while(sent < QUEUE_BLOCK){
+      size_t size = spsc_enqueue64_n(queue, &block[sent], QUEUE_BLOCK - sent);
+      if(size == 0) sched_yield();
+      sent += size;
+    }
+    next += QUEUE_BLOCK;
+  }
+  return NULL;
+}
@@ -95,6 +95,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+//the batch moves use AVX2 when the processor has it (see rotate_batch)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AVX2_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#endif
+#define LANES 8 //cubes moved by one pass of an AVX2 kernel
+
 //Powers of 21
 #define c21_6 (85766121)
 #define c21_5 (4084101)
@@ -113,13 +121,37 @@ static char four[3] = {'o','y','g'};
 static char five[3] = {'r','y','g'};
 static char six[3] = {'o','y','b'};
 
+//powers of 21 indexed by piece, used when ranking and unranking a cube
+static int c21[7] = {c21_0, c21_1, c21_2, c21_3, c21_4, c21_5, c21_6};
+
+//factorials used by the permutation rank (Lehmer code)
+static int factorial[7] = {1, 1, 2, 6, 24, 120, 720};
+
+/** The following tables hold the result of each turn on the two parts of a 
+  * rank (see rotate_rank).
+  * EX: perm_move_table[10][3] holds the permutation rank that results from 
+  *     performing a left clockwise turn on permutation 10
+  * Each table has an unused last row, so that a 4 byte vector gather of the 
+  * last entry stays inside the table.
+  * They are generated from turn_table when the solver is built, with the
+  * tables that unrank the two parts (perm_unrank_table[rank] holds the
+  * piece in each position, orient_unrank_table[rank] the orientation at
+  * each position). Only gen_move_tables builds them at run time.
+  */
+#ifdef MOVE_TABLE_GENERATOR
+unsigned short perm_move_table[NUMBER_OF_PERMUTATIONS + 1][6];
+unsigned short orient_move_table[NUMBER_OF_ORIENTATIONS + 1][6];
+#else
+#include "move_tables.h"
+#endif
+
 /** The following table is based on Annitti Valmari's paper (see table 1)
   * the rows represent the different types of turns 
   * Each the columns are indexed by the state
   * EX: turn_table[3][4] holds the state that results from performing a left
   *     clockwise turn on a piece in the fifth state
   */
-static int turn_table[6][21] = {
+static const int turn_table[6][21] = {
   {4,5,3,11,9,10,1,2,0,8,6,7,12,13,14,15,16,17,18,19,20}, //front CC
   {8,6,7,2,0,1,10,11,9,4,5,3,12,13,14,15,16,17,18,19,20}, //Front C
   {13,14,12,1,2,0,6,7,8,9,10,11,17,15,16,5,3,4,18,19,20}, //Left CC
@@ -157,9 +189,9 @@ char state_table1247[21][3] = {
   {1,2,0}, {2,0,1}, {0,1,2},
   {0,1,2}, {1,2,0}, {2,0,1},
   {1,0,2}, {2,1,0}, {0,2,1},
-  {2,1,0}, {0,1,2}, {1,0,2},
+  {2,0,1}, {0,1,2}, {1,2,0},
   {1,0,2}, {2,1,0}, {0,2,1},
-  {2,1,0}, {1,0,2}, {0,2,1}};
+  {1,0,2}, {2,1,0}, {0,2,1}};
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
@@ -167,9 +199,19 @@ char state_table1247[21][3] = {
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
  
 void insert(Cube* cube_S, char* piece_colors, int piece, int state);
-Cube* make_cube();
+void init_cube(Cube* cube);
 int move_piece (int curr_state, int turn);
-int rotate(int cube, int turn);
+int rank_permutation(char* piece_at);
+void unrank_permutation(int rank, char* piece_at);
+int rank_orientation(char* orient_at);
+void unrank_orientation(int rank, char* orient_at);
+int use_avx2();
+#ifdef AVX2_KERNELS
+static inline AVX2 __m256i divide_avx2(__m256i x, unsigned int magic, 
+                                       int shift);
+AVX2 void rotate_avx2(int* cubes, const int* states);
+AVX2 void rotate_rank_avx2(int* ranks, const char* turns, int turn);
+#endif
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Cube Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
@@ -226,9 +268,20 @@ int topC(int cube){
 /** This function consumes an integer representation of a cube and converts it
   * to the Cube struct.
   * @param cube The integer representation of the cube
-  * @return A pointer to the Cube struct
+  * @return A pointer to the Cube struct (to be freed by the caller)
   */
 Cube* decompress(int cube){
+  Cube* my_cube = malloc(sizeof(Cube));
+  if(my_cube != NULL) decompress_into(cube, my_cube);
+  return my_cube;
+}
+
+/** This function consumes an integer representation of a cube and converts it
+  * into a Cube struct owned by the caller (EX: on the stack).
+  * @param cube The integer representation of the cube
+  * @param my_cube Pointer to the Cube struct to be filled
+  */
+void decompress_into(int cube, Cube* my_cube){
 
   //determine the states of each piece
   int state6 = cube / c21_6;
@@ -244,8 +297,7 @@ Cube* decompress(int cube){
   int state1 = cube / c21_1;
   int state0 = cube % c21_1;
 
-  Cube* my_cube = make_cube();
-
+  init_cube(my_cube);
 
   //place the pieces in the cube struct
   insert(my_cube, six, 6, state6);
@@ -255,8 +307,6 @@ Cube* decompress(int cube){
   insert(my_cube, two, 2, state2);
   insert(my_cube, one, 1, state1);
   insert(my_cube, zero, 0, state0);
-
-  return my_cube;
 }
 
 /** This function displays a Cube struct to the screen
@@ -276,18 +326,270 @@ void print_cube(Cube* cube){
 
 }
 
+/** This function converts the integer representation of a cube into its
+  * perfect rank (see cube.h). The rank indexes every reachable cube with no
+  * gaps, so it can be used directly as an index into a table.
+  * @param cube The integer representation of the cube
+  * @return The rank of the cube (0 - 3,674,159)
+  * @return -1 The integer does not represent a reachable cube
+  */
+int rank_cube(int cube){
+  if(cube < 0 || cube >= 7 * c21_6 * 3) return -1; //21^7 states at most
+
+  char piece_at[7]; //piece_at[pos] is the piece in that position
+  char orient_at[7]; //orient_at[pos] is the orientation at that position
+  int used = 0; //bit mask of the positions that hold a piece
+  int orient_sum = 0;
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    int state = cube % c21_1;
+    cube /= c21_1;
+    int pos = state / 3;
+    if(used & (1 << pos)) return -1; //two pieces in one position
+    used |= 1 << pos;
+    piece_at[pos] = piece;
+    orient_at[pos] = state % 3;
+    orient_sum += state % 3;
+  }
+  if(orient_sum % 3 != 0) return -1; //a single corner is twisted
+
+  return (rank_permutation(piece_at) * NUMBER_OF_ORIENTATIONS) +
+         rank_orientation(orient_at);
+}
+
+/** This function converts the rank of a cube back into its integer
+  * representation. It is the inverse of rank_cube.
+  * @param rank The rank of the cube (0 - 3,674,159)
+  * @return The integer representation of the cube
+  * @return -1 The rank is out of range
+  */
+int unrank_cube(int rank){
+  if(rank < 0 || rank >= NUMBER_OF_PERMUTATIONS * NUMBER_OF_ORIENTATIONS)
+    return -1;
+
+#ifdef MOVE_TABLE_GENERATOR
+  char piece_at[7];
+  char orient_at[7];
+  unrank_permutation(rank / NUMBER_OF_ORIENTATIONS, piece_at);
+  unrank_orientation(rank % NUMBER_OF_ORIENTATIONS, orient_at);
+#else
+  const char* piece_at = perm_unrank_table[rank / NUMBER_OF_ORIENTATIONS];
+  const char* orient_at = orient_unrank_table[rank % NUMBER_OF_ORIENTATIONS];
+#endif
+
+  int cube = 0;
+  int pos;
+  for(pos = 0; pos < 7; pos++){
+    cube += ((pos * 3) + orient_at[pos]) * c21[(int) piece_at[pos]];
+  }
+  return cube;
+}
+
+/** This function builds the permutation and orientation move tables from
+  * turn_table. A turn moves the piece in each position to a new position and
+  * changes its orientation based only on the position, so the permutation 
+  * and the orientation parts of the rank can be turned independently.
+  * Only gen_move_tables calls it: the solver is built with the tables
+  * already in it (see gen_move_tables.c).
+  */
+#ifdef MOVE_TABLE_GENERATOR
+void init_move_tables(){
+
+  char before[7];
+  char after[7];
+  int rank, turn, pos;
+  for(rank = 0; rank < NUMBER_OF_PERMUTATIONS; rank++){
+    unrank_permutation(rank, before);
+    for(turn = 0; turn < 6; turn++){
+      for(pos = 0; pos < 7; pos++){
+        after[turn_table[turn][pos * 3] / 3] = before[pos];
+      }
+      perm_move_table[rank][turn] = rank_permutation(after);
+    }
+  }
+  for(rank = 0; rank < NUMBER_OF_ORIENTATIONS; rank++){
+    unrank_orientation(rank, before);
+    for(turn = 0; turn < 6; turn++){
+      for(pos = 0; pos < 7; pos++){
+        int state = turn_table[turn][(pos * 3) + before[pos]];
+        after[state / 3] = state % 3;
+      }
+      orient_move_table[rank][turn] = rank_orientation(after);
+    }
+  }
+}
+#endif
+
+/** This function performs a rotation on the rank of a cube, using two table
+  * loads instead of decoding the cube.
+  * @param rank The rank of the cube to be turned
+  * @param turn The type of turn (ex front counter clockwise)
+  * @return the rank of the turned cube.
+  */
+int rotate_rank(int rank, int turn){
+  int perm = rank / NUMBER_OF_ORIENTATIONS;
+  int orient = rank % NUMBER_OF_ORIENTATIONS;
+  return (perm_move_table[perm][turn] * NUMBER_OF_ORIENTATIONS) +
+         orient_move_table[orient][turn];
+}
+
+/** This function performs the same rotation on a batch of cubes. With AVX2,
+  * 8 cubes are decoded, turned and rebuilt at once: the divisions by 21 
+  * become multiplications, and the turn table is read with a vector gather.
+  * @param cubes The cubes to be turned (replaced by the turned cubes)
+  * @param n The number of cubes
+  * @param turn The type of turn (ex front counter clockwise)
+  */
+void rotate_batch(int* cubes, size_t n, int turn){
+  size_t i = 0;
+#ifdef AVX2_KERNELS
+  if(use_avx2()){
+    for(; i + LANES <= n; i += LANES){
+      rotate_avx2(&cubes[i], turn_table[turn]);
+    }
+  }
+#endif
+  for(; i < n; i++){
+    cubes[i] = rotate(cubes[i], turn);
+  }
+}
+
+/** This function performs the same rotation on a batch of ranks (see 
+  * rotate_rank).
+  * @param ranks The ranks to be turned (replaced by the turned ranks)
+  * @param n The number of ranks
+  * @param turn The type of turn (ex front counter clockwise)
+  */
+void rotate_rank_batch(int* ranks, size_t n, int turn){
+  size_t i = 0;
+#ifdef AVX2_KERNELS
+  if(use_avx2()){
+    for(; i + LANES <= n; i += LANES){
+      rotate_rank_avx2(&ranks[i], NULL, turn);
+    }
+  }
+#endif
+  for(; i < n; i++){
+    ranks[i] = rotate_rank(ranks[i], turn);
+  }
+}
+
+/** This function performs a rotation on each rank of a batch, where each
+  * rank has its own type of turn.
+  * @param ranks The ranks to be turned (replaced by the turned ranks)
+  * @param turns The type of turn for each rank (0 - 5)
+  * @param n The number of ranks
+  */
+void rotate_rank_each(int* ranks, const char* turns, size_t n){
+  size_t i = 0;
+#ifdef AVX2_KERNELS
+  if(use_avx2()){
+    for(; i + LANES <= n; i += LANES){
+      rotate_rank_avx2(&ranks[i], &turns[i], 0);
+    }
+  }
+#endif
+  for(; i < n; i++){
+    ranks[i] = rotate_rank(ranks[i], turns[i]);
+  }
+}
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
+/** This function checks once whether the processor can run the AVX2 kernels
+  * @return 1 The AVX2 kernels can be used
+  * @return 0 Use the scalar moves
+  */
+int use_avx2(){
+#ifdef AVX2_KERNELS
+  static int supported = -1;
+  if(supported == -1) supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+  return supported;
+#else
+  return 0;
+#endif
+}
+
+#ifdef AVX2_KERNELS
+/** This function divides 8 numbers by a constant, using a multiplication by
+  * the constant's magic number and a shift: x / d = (x * magic) >> shift
+  * @param x The numbers to divide
+  * @param magic The magic number of the divisor
+  * @param shift The shift of the divisor (32 or more)
+  * @return The quotients
+  */
+static inline AVX2 __m256i divide_avx2(__m256i x, unsigned int magic, 
+                                       int shift){
+  __m256i m = _mm256_set1_epi32(magic);
+  __m256i even = _mm256_mul_epu32(x, m);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+  even = _mm256_srli_epi64(even, shift);
+  odd = _mm256_slli_epi64(_mm256_srli_epi64(odd, shift), 32);
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/** This function performs a rotation on 8 cubes (see rotate)
+  * @param cubes The 8 cubes to be turned
+  * @param states The row of turn_table for the turn
+  */
+AVX2 void rotate_avx2(int* cubes, const int* states){
+  __m256i x = _mm256_loadu_si256((const __m256i*) cubes);
+  __m256i cube = _mm256_setzero_si256();
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    //x / 21 = (x * 3272356036) >> 36 for every x below 2^31
+    __m256i rest = divide_avx2(x, 3272356036u, 36);
+    __m256i state = _mm256_sub_epi32(x, 
+                      _mm256_mullo_epi32(rest, _mm256_set1_epi32(21)));
+    state = _mm256_i32gather_epi32(states, state, 4);
+    cube = _mm256_add_epi32(cube, 
+             _mm256_mullo_epi32(state, _mm256_set1_epi32(c21[piece])));
+    x = rest;
+  }
+  _mm256_storeu_si256((__m256i*) cubes, cube);
+}
+
+/** This function performs a rotation on 8 ranks (see rotate_rank)
+  * @param ranks The 8 ranks to be turned
+  * @param turns The type of turn for each rank, or NULL to use turn
+  * @param turn The type of turn for every rank (when turns is NULL)
+  */
+AVX2 void rotate_rank_avx2(int* ranks, const char* turns, int turn){
+  __m256i rank = _mm256_loadu_si256((const __m256i*) ranks);
+  __m256i turn_lanes = (turns == NULL) ? _mm256_set1_epi32(turn) :
+    _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*) turns));
+  __m256i orients = _mm256_set1_epi32(NUMBER_OF_ORIENTATIONS);
+  __m256i six = _mm256_set1_epi32(6);
+  __m256i low_half = _mm256_set1_epi32(0xFFFF);
+
+  //rank / 729 = (rank * 5891588) >> 32 for every rank
+  __m256i perm = divide_avx2(rank, 5891588u, 32);
+  __m256i orient = _mm256_sub_epi32(rank, _mm256_mullo_epi32(perm, orients));
+
+  //each gather reads 4 bytes, the table entry is the low 2 (little endian)
+  __m256i perm_index = _mm256_add_epi32(_mm256_mullo_epi32(perm, six),
+                                        turn_lanes);
+  __m256i orient_index = _mm256_add_epi32(_mm256_mullo_epi32(orient, six),
+                                          turn_lanes);
+  perm = _mm256_and_si256(low_half, _mm256_i32gather_epi32(
+           (const int*) perm_move_table, perm_index, 2));
+  orient = _mm256_and_si256(low_half, _mm256_i32gather_epi32(
+             (const int*) orient_move_table, orient_index, 2));
+
+  rank = _mm256_add_epi32(_mm256_mullo_epi32(perm, orients), orient);
+  _mm256_storeu_si256((__m256i*) ranks, rank);
+}
+#endif
+
 /** This function inserts a piece into a cube data structure
   * @param cube Pointer to the cube struct
   * @param piece character array representing the piece's colors
   * @param state state of the piece
   */
 void insert(Cube* cube_S, char* piece_colors, int piece, int state){
-  char colorTB, colorFB, colorRL; //top-bottom, front-back, right-left
+  int colorTB, colorFB, colorRL; //top-bottom, front-back, right-left
   if (piece == 0 || piece == 3 || piece == 5 || piece == 6){
     colorTB = state_table0356[state][0];
     colorFB = state_table0356[state][1];
@@ -344,11 +646,10 @@ void insert(Cube* cube_S, char* piece_colors, int piece, int state){
   }
 }
 
-/** This function allocates memory for a cube an intializes all the data.
-  * @return Pointer to the cube struct.
+/** This function intializes all the data of a cube struct.
+  * @param cube Pointer to the cube struct.
   */
-Cube* make_cube(){
-  Cube* cube = malloc(sizeof(Cube));
+void init_cube(Cube* cube){
   int i,j;
   for(i = 0; i < 6; i++){
     for(j = 0; j < 8; j++){
@@ -359,7 +660,75 @@ Cube* make_cube(){
   cube->cube[5][3] = 'r';
   cube->cube[3][5] = 'b';
   cube->cube[3][6] = 'y';
-  return cube;
+}
+
+/** This function computes the Lehmer code of the pieces in positions 0-6
+  * @param piece_at piece_at[pos] is the piece in that position
+  * @return The permutation rank (0 - 5039)
+  */
+int rank_permutation(char* piece_at){
+  int rank = 0;
+  int remaining = 0x7F; //bit mask of the pieces not yet placed
+  int pos;
+  for(pos = 0; pos < 6; pos++){
+    //count the smaller pieces in the remaining positions
+    int smaller = __builtin_popcount(remaining & ((1 << piece_at[pos]) - 1));
+    rank += smaller * factorial[6 - pos];
+    remaining &= ~(1 << piece_at[pos]);
+  }
+  return rank;
+}
+
+/** This function converts a permutation rank back into the pieces in 
+  * positions 0-6
+  * @param rank The permutation rank (0 - 5039)
+  * @param piece_at Filled such that piece_at[pos] is the piece in that position
+  */
+void unrank_permutation(int rank, char* piece_at){
+  int remaining = 0x7F; //bit mask of the pieces not yet placed
+  int pos;
+  for(pos = 0; pos < 7; pos++){
+    //the Lehmer digit selects the n-th smallest remaining piece
+    int smaller = rank / factorial[6 - pos];
+    rank %= factorial[6 - pos];
+    int piece = -1;
+    do{
+      piece++;
+      if(remaining & (1 << piece)) smaller--;
+    }while(smaller >= 0);
+    remaining &= ~(1 << piece);
+    piece_at[pos] = piece;
+  }
+}
+
+/** This function computes the orientation rank of positions 0-5
+  * @param orient_at orient_at[pos] is the orientation at that position
+  * @return The orientation rank (0 - 728)
+  */
+int rank_orientation(char* orient_at){
+  int rank = 0;
+  int pos;
+  for(pos = 5; pos >= 0; pos--){
+    rank = (rank * 3) + orient_at[pos];
+  }
+  return rank;
+}
+
+/** This function converts an orientation rank back into the orientations at
+  * positions 0-6. The orientation at position 6 is the one that makes the 
+  * orientations sum to 0 (mod 3).
+  * @param rank The orientation rank (0 - 728)
+  * @param orient_at Filled such that orient_at[pos] is the orientation there
+  */
+void unrank_orientation(int rank, char* orient_at){
+  int orient_sum = 0;
+  int pos;
+  for(pos = 0; pos < 6; pos++){
+    orient_at[pos] = rank % 3;
+    orient_sum += rank % 3;
+    rank /= 3;
+  }
+  orient_at[6] = (3 - (orient_sum % 3)) % 3;
 }
 
 /** This function performs a rotation on a cube. 
@@ -391,6 +760,16 @@ int rotate(int cube, int turn){
          (state4 * c21_4) + (state5 * c21_5) + (state6 * c21_6);
 }
 
+/** This function performs a rotation on the state of a single piece (its
+  * position and orientation, see rotate)
+  * @param state The state of the piece (0 - 20)
+  * @param turn The rotation (0 - 5)
+  * @return The state of the piece after the rotation
+  */
+int rotate_piece(int state, int turn){
+  return turn_table[turn][state];
+}
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~ TESTING FUNCTIONS ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
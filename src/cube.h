@@ -8,6 +8,23 @@
 #ifndef CUBE_H
 #define CUBE_H
 
+#include <stddef.h>
+
+  /** Every reachable cube has a perfect rank in [0, 3,674,160).
+    * rank = permutation_rank * 729 + orientation_rank
+    * permutation_rank: Lehmer code of the pieces in positions 0-6 (7! = 5040)
+    * orientation_rank: orientations at positions 0-5 in base 3 (3^6 = 729),
+    *   the orientation at position 6 is fixed by the other six.
+    */
+  #define NUMBER_OF_PERMUTATIONS 5040
+  #define NUMBER_OF_ORIENTATIONS 729
+
+  /** Turn codes: a solution is a sequence of turn codes ending with 0, and
+    * code n makes the turn rotate(cube, n - 1):
+    *   1:FCC  2:FC  3:LCC  4:LC  5:TCC  6:TC   (F' F L' L U' U)
+    * The state tables store the code of the turn that solves each cube.
+    */
+
   /** The following is a simple structure to represent a cube. 
     * When a cube needs to be stored or operated on efficiently, 
     * the integer implementation will be used, 
@@ -34,8 +51,34 @@
   int leftC(int cube);
   int topCC(int cube);
   int topC(int cube);
+  int rotate(int cube, int turn);
+  int rotate_piece(int state, int turn);
+  void rotate_batch(int* cubes, size_t n, int turn);
+
+  int rank_cube(int cube);
+  int unrank_cube(int rank);
+
+  //move engine on ranks (see rotate_rank in cube.c), the tables are
+  //generated into move_tables.h by the build and only written at run time
+  //by the generator (init_move_tables)
+  #ifdef MOVE_TABLE_GENERATOR
+  #define MOVE_TABLE
+  #else
+  #define MOVE_TABLE const
+  #endif
+  extern MOVE_TABLE unsigned short
+    perm_move_table[NUMBER_OF_PERMUTATIONS + 1][6];
+  extern MOVE_TABLE unsigned short
+    orient_move_table[NUMBER_OF_ORIENTATIONS + 1][6];
+  #ifdef MOVE_TABLE_GENERATOR
+  void init_move_tables();
+  #endif
+  int rotate_rank(int rank, int turn);
+  void rotate_rank_batch(int* ranks, size_t n, int turn);
+  void rotate_rank_each(int* ranks, const char* turns, size_t n);
 
   Cube* decompress(int cube);
+  void decompress_into(int cube, Cube* my_cube);
   void print_cube(Cube* cube);
 
 #endif
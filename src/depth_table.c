@@ -0,0 +1,365 @@
+/** File: depth_table.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the functions used to store the distance of every cube
+  * from the solved cube in the file:
+  *   depth_table.bin
+  *
+  * Every cube can be solved in 14 moves or less, so the depth of a cube fits
+  * in 4 bits, and two depths are packed into every byte (the even rank in
+  * the low half). This means 3,674,160 / 2 = 1,837,080 bytes are needed.
+  *
+  * The depth answers "how far from solved is this cube" with one table load.
+  * The optimal moves for a cube are the moves that lead to a cube one move 
+  * closer to solved, so probing the depths of the six neighbours gives every
+  * optimal move (the ranked table only stores one of them).
+  *
+  * The depth of a neighbour is always one less, the same or one more, so the
+  * depth modulo 3 is enough to pick out the neighbours one move closer. That
+  * takes 2 bits per cube (3 marks a cube that was not reached), or
+  * 3,674,160 / 4 = 918,540 bytes, and is saved in the file:
+  *   mod3_table.bin
+  * The mod 3 table can be mapped and solved
+  * from directly, or decoded into a ranked table with one pass.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "state_table.h"
+#include "depth_table.h"
+#include "table_file.h"
+#include "queue.h"
+#include "cube.h"
+#include "metrics.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void set_depth(uint8_t* depth_table, int rank, int depth);
+void set_mod3(uint8_t* mod3_table, int rank, int mod3);
+int closer_rotation(const uint8_t* mod3_table, int rank);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Depth_table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates a byte array to store the depth table.
+  * @return A pointer to the array of bytes
+  */
+uint8_t* make_depth_table(){
+  uint8_t* depth_table = (uint8_t*) calloc(DEPTH_TABLE_SIZE, 1);
+  return depth_table;
+}
+
+/** Fills an empty depth table with a breadth first search from the solved
+  * cube. Cubes are dequeued in order of depth, so a cube that is reached for
+  * the first time is one move deeper than the cube it was reached from.
+  * @param depth_table The depth table to be filled
+  * @return 1 The table was completely filled
+  * @return 0 The table was not completely filled
+  */
+int generate_depth_table(uint8_t* depth_table){
+  Queue64* queue = createQueue64(0);
+  if(queue == NULL) return 0;
+
+  memset(depth_table, 0xFF, DEPTH_TABLE_SIZE);
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  set_depth(depth_table, solved_rank, 0);
+  enqueue64(queue, solved_rank);
+  int count = 1;
+  int filled = 1;
+  METRIC_BFS_BEGIN();
+
+  uint64_t entry;
+  while(filled && dequeue64(queue, &entry) == QUEUE_OK){
+    int this_rank = (int) entry;
+    int depth = depth_at(depth_table, this_rank) + 1;
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      int rank = rotate_rank(this_rank, rotation);
+      if(depth_at(depth_table, rank) == UNKNOWN_DEPTH){
+        set_depth(depth_table, rank, depth);
+        if(enqueue64(queue, rank) != QUEUE_OK) filled = 0;
+        count++;
+      }
+    }
+    METRIC_BFS_VISIT(count);
+  }
+  deleteQueue64(queue);
+  return filled && count == NUMBER_OF_CUBES;
+}
+
+/** This function writes a depth table, with a table header, to the binary 
+  * file depth_table.bin (see table_file.c)
+  * @param depth_table The table to write to memory
+  */
+void write_depth_table(const uint8_t* depth_table){
+  if(!save_state_table("depth_table.bin", TABLE_DEPTH, depth_table,
+                       DEPTH_TABLE_SIZE))
+    printf("An error occured while writing to depth_table.bin.\n");
+}
+
+/** This function reads the depth stored for a rank in the depth table
+  * @param depth_table The depth table
+  * @param rank The rank of the cube
+  * @return The number of moves needed to solve the cube
+  */
+int depth_at(const uint8_t* depth_table, int rank){
+  return (depth_table[rank / 2] >> ((rank % 2) * 4)) & 0x0F;
+}
+
+/** This function returns the number of moves needed to solve a cube
+  * @param depth_table The finished depth table
+  * @param cube The cube 
+  * @return The number of moves needed to solve the cube (0 - 14)
+  * @return -1 cube does not exist
+  */
+int get_depth(const uint8_t* depth_table, int cube){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+  return depth_at(depth_table, rank);
+}
+
+/** This function finds every optimal next move for a cube, by probing the 
+  * depths of its six neighbours.
+  * @param depth_table The finished depth table
+  * @param cube The cube 
+  * @param turns At least 6 chars, filled with the optimal moves as turns 
+  *    (as returned by solve_cube: turn n is undone by rotation n - 1)
+  *    (see the turn codes in cube.h)
+  * @return The number of optimal moves (0 for the solved cube)
+  * @return -1 cube does not exist
+  */
+int get_optimal_turns(const uint8_t* depth_table, int cube, char* turns){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+
+  int depth = depth_at(depth_table, rank);
+  int count = 0;
+  int rotation;
+  for(rotation = 0; rotation < 6 && depth > 0; rotation++){
+    if(depth_at(depth_table, rotate_rank(rank, rotation)) == depth - 1){
+      turns[count++] = rotation + 1;
+    }
+  }
+  return count;
+}
+
+/** This function returns the first optimal turn for a cube, so that a depth 
+  * table can stand in for the ranked table.
+  * @param depth_table The finished depth table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn (0 when solved).
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist
+  */
+char get_depth_turn(const uint8_t* depth_table, int cube){
+  char turns[6];
+  int count = get_optimal_turns(depth_table, cube, turns);
+  if(count == -1) return -1;
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  return (count == 0) ? 0 : turns[0];
+}
+
+/** This funciton solves a cube using the depth table, into a buffer owned by
+  * the caller.
+  * @param cube The cube to be solved
+  * @param depth_table The depth table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_depth_cube_into(int cube, const uint8_t* depth_table,
+                          char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+
+  int depth = depth_at(depth_table, rank);
+  if(depth >= SOLUTION_SIZE) return -1; //corrupt table
+  METRIC_ADD(METRIC_GET_TURN_CALLS, depth + 1);
+  int count;
+  for(count = 0; count < depth; count++){
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      int next = rotate_rank(rank, rotation);
+      if(depth_at(depth_table, next) == depth - count - 1){
+        rank = next;
+        break;
+      }
+    }
+    if(rotation == 6) return -1; //corrupt table
+    turn_sequence[count] = rotation + 1;
+  }
+  turn_sequence[depth] = 0;
+  return depth;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Mod 3 Table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates a byte array to store the mod 3 table.
+  * @return A pointer to the array of bytes
+  */
+uint8_t* make_mod3_table(){
+  uint8_t* mod3_table = (uint8_t*) calloc(MOD3_TABLE_SIZE, 1);
+  return mod3_table;
+}
+
+/** This function fills a mod 3 table from a finished depth table
+  * @param depth_table The finished depth table
+  * @param mod3_table The mod 3 table to be filled
+  * @return 1 The table was filled
+  * @return 0 The depth table has a cube it did not reach
+  */
+int reduce_depth_table(const uint8_t* depth_table, uint8_t* mod3_table){
+  memset(mod3_table, 0xFF, MOD3_TABLE_SIZE);
+  int rank;
+  for(rank = 0; rank < NUMBER_OF_CUBES; rank++){
+    int depth = depth_at(depth_table, rank);
+    if(depth == UNKNOWN_DEPTH) return 0;
+    set_mod3(mod3_table, rank, depth % 3);
+  }
+  return 1;
+}
+
+/** This function writes a mod 3 table, with a table header, to the binary 
+  * file mod3_table.bin (see table_file.c)
+  * @param mod3_table The table to write to memory
+  */
+void write_mod3_table(const uint8_t* mod3_table){
+  if(!save_state_table("mod3_table.bin", TABLE_DEPTH_MOD3, mod3_table,
+                       MOD3_TABLE_SIZE))
+    printf("An error occured while writing to mod3_table.bin.\n");
+}
+
+/** This function reads the depth modulo 3 stored for a rank
+  * @param mod3_table The mod 3 table
+  * @param rank The rank of the cube
+  * @return The number of moves needed to solve the cube, modulo 3
+  * @return UNKNOWN_MOD3 The cube was not reached
+  */
+int mod3_at(const uint8_t* mod3_table, int rank){
+  return (mod3_table[rank / 4] >> ((rank % 4) * 2)) & 0x03;
+}
+
+/** This function returns the first optimal turn for a cube, so that a mod 3
+  * table can stand in for the ranked table.
+  * @param mod3_table The mod 3 table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn (0 when solved).
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist (or the table is corrupt)
+  */
+char get_mod3_turn(const uint8_t* mod3_table, int cube){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+  if(rank == rank_cube(SOLVED_CUBE)) return 0;
+
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  int rotation = closer_rotation(mod3_table, rank);
+  return (rotation == -1) ? -1 : rotation + 1;
+}
+
+/** This funciton solves a cube using the mod 3 table, into a buffer owned by
+  * the caller.
+  * @param cube The cube to be solved
+  * @param mod3_table The mod 3 table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_mod3_cube_into(int cube, const uint8_t* mod3_table,
+                         char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  int count = 0;
+  while(rank != solved_rank){
+    METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+    int rotation = closer_rotation(mod3_table, rank);
+    if(rotation == -1 || count == SOLUTION_SIZE - 1) return -1; //corrupt
+    turn_sequence[count++] = rotation + 1;
+    rank = rotate_rank(rank, rotation);
+  }
+  turn_sequence[count] = 0;
+  return count;
+}
+
+/** This function decodes a mod 3 table into a ranked table, so that a table
+  * shipped as mod3_table.bin solves at the speed of the ranked table. Each
+  * cube is given the first turn to a neighbour one move closer to solved.
+  * @param mod3_table The mod 3 table
+  * @param ranked_table The ranked table to be filled
+  * @return 1 The table was decoded
+  * @return 0 The mod 3 table is corrupt
+  */
+int decode_mod3_table(const uint8_t* mod3_table, uint64_t* ranked_table){
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  memset(ranked_table, 0, RANKED_TABLE_WORDS * sizeof(uint64_t));
+  int rank;
+  for(rank = 0; rank < NUMBER_OF_CUBES; rank++){
+    if(rank == solved_rank) continue; //turn 0
+    int rotation = closer_rotation(mod3_table, rank);
+    if(rotation == -1) return 0;
+    set_ranked_turn(ranked_table, rank, rotation + 1);
+  }
+  return 1;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function stores the depth of a cube in the depth table
+  * @param depth_table The depth table
+  * @param rank The rank of the cube
+  * @param depth The number of moves needed to solve the cube
+  */
+void set_depth(uint8_t* depth_table, int rank, int depth){
+  int shift = (rank % 2) * 4;
+  depth_table[rank / 2] = (depth_table[rank / 2] & ~(0x0F << shift)) |
+                          (depth << shift);
+}
+
+/** This function stores the depth modulo 3 of a cube in the mod 3 table
+  * @param mod3_table The mod 3 table
+  * @param rank The rank of the cube
+  * @param mod3 The number of moves needed to solve the cube, modulo 3
+  */
+void set_mod3(uint8_t* mod3_table, int rank, int mod3){
+  int shift = (rank % 4) * 2;
+  mod3_table[rank / 4] = (mod3_table[rank / 4] & ~(0x03 << shift)) |
+                         (mod3 << shift);
+}
+
+/** This function finds a rotation that takes a cube (other than the solved
+  * cube) one move closer to solved: a neighbour with the depth modulo 3 one
+  * less than the cube.
+  * @param mod3_table The mod 3 table
+  * @param rank The rank of the cube
+  * @return The rotation (0 - 5)
+  * @return -1 No neighbour is closer (the table is corrupt)
+  */
+int closer_rotation(const uint8_t* mod3_table, int rank){
+  int mod3 = mod3_at(mod3_table, rank);
+  if(mod3 == UNKNOWN_MOD3) return -1;
+  int closer = (mod3 + 2) % 3;
+  int rotation;
+  for(rotation = 0; rotation < 6; rotation++){
+    if(mod3_at(mod3_table, rotate_rank(rank, rotation)) == closer){
+      return rotation;
+    }
+  }
+  return -1;
+}
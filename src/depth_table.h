@@ -0,0 +1,38 @@
+/** File: depth_table.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file depth_table.c
+  */
+
+#ifndef DEPTH_TABLE_H
+#define DEPTH_TABLE_H
+
+#include <stdint.h>
+#include "state_table.h"
+
+#define DEPTH_TABLE_SIZE (NUMBER_OF_CUBES / 2) //two 4 bit depths per byte
+#define UNKNOWN_DEPTH 0x0F //depth of a cube the generator has not reached
+#define MOD3_TABLE_SIZE ((NUMBER_OF_CUBES + 3) / 4) //four 2 bit depths per byte
+#define UNKNOWN_MOD3 0x03 //depth modulo 3 of a cube that was not reached
+
+//Function Prototypes
+uint8_t* make_depth_table();
+int generate_depth_table(uint8_t* depth_table);
+void write_depth_table(const uint8_t* depth_table);
+int depth_at(const uint8_t* depth_table, int rank);
+int get_depth(const uint8_t* depth_table, int cube);
+int get_optimal_turns(const uint8_t* depth_table, int cube, char* turns);
+char get_depth_turn(const uint8_t* depth_table, int cube);
+int solve_depth_cube_into(int cube, const uint8_t* depth_table,
+                          char* turn_sequence);
+
+uint8_t* make_mod3_table();
+int reduce_depth_table(const uint8_t* depth_table, uint8_t* mod3_table);
+void write_mod3_table(const uint8_t* mod3_table);
+int mod3_at(const uint8_t* mod3_table, int rank);
+char get_mod3_turn(const uint8_t* mod3_table, int cube);
+int solve_mod3_cube_into(int cube, const uint8_t* mod3_table,
+                         char* turn_sequence);
+int decode_mod3_table(const uint8_t* mod3_table, uint64_t* ranked_table);
+
+#endif
@@ -0,0 +1,104 @@
+/** File: gen_move_tables.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file is the build step that writes move_tables.h, the move and
+  * unrank tables of the move engine in cube.c.
+  *
+  * It is linked with a copy of cube.c built with -DMOVE_TABLE_GENERATOR,
+  * which still builds the move tables from turn_table at run time (see
+  * init_move_tables). Their contents are printed as C initializers, so the
+  * solver gets them as read-only data with no work at startup, and they are
+  * rebuilt whenever cube.c changes, so they cannot drift from turn_table.
+  * The program takes no arguments and writes the header to stdout.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include "cube.h"
+
+#define ROWS_PER_LINE 2 //rows of a table printed on one line
+
+//the Lehmer code and orientation helpers of cube.c
+void unrank_permutation(int rank, char* piece_at);
+void unrank_orientation(int rank, char* orient_at);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void print_move_table(const char* name, int rows,
+                      unsigned short (*move_table)[6]);
+void print_unrank_table(const char* name, int rows,
+                        void (*unrank)(int rank, char* at));
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~ Generator Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+int main(){
+  init_move_tables();
+  printf("/** File: move_tables.h\n"
+         "  * Generated by gen_move_tables from turn_table in cube.c when the\n"
+         "  * solver is built. Do not edit; it is included once, by cube.c.\n"
+         "  */\n\n"
+         "#ifndef MOVE_TABLES_H\n"
+         "#define MOVE_TABLES_H\n\n");
+  print_move_table("perm_move_table", NUMBER_OF_PERMUTATIONS,
+                   perm_move_table);
+  print_move_table("orient_move_table", NUMBER_OF_ORIENTATIONS,
+                   orient_move_table);
+  print_unrank_table("perm_unrank_table", NUMBER_OF_PERMUTATIONS,
+                     unrank_permutation);
+  print_unrank_table("orient_unrank_table", NUMBER_OF_ORIENTATIONS,
+                     unrank_orientation);
+  printf("#endif\n");
+  return ferror(stdout) ? 1 : 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function prints a move table, with its unused last row (see cube.c)
+  * @param name The name of the table
+  * @param rows The number of rows in use
+  * @param move_table The table built by init_move_tables
+  */
+void print_move_table(const char* name, int rows,
+                      unsigned short (*move_table)[6]){
+  printf("const unsigned short %s[%d][6] = {", name, rows + 1);
+  int row, turn;
+  for(row = 0; row <= rows; row++){
+    printf("%s{", (row % ROWS_PER_LINE == 0) ? "\n  " : " ");
+    for(turn = 0; turn < 6; turn++){
+      printf("%s%d", (turn == 0) ? "" : ",",
+             (row < rows) ? move_table[row][turn] : 0);
+    }
+    printf("}%s", (row < rows) ? "," : "");
+  }
+  printf("};\n\n");
+}
+
+/** This function prints the table that undoes a rank into the 7 values of
+  * its positions (see unrank_permutation and unrank_orientation)
+  * @param name The name of the table
+  * @param rows The number of ranks
+  * @param unrank The function that fills the 7 values of a rank
+  */
+void print_unrank_table(const char* name, int rows,
+                        void (*unrank)(int rank, char* at)){
+  printf("static const char %s[%d][7] = {", name, rows);
+  char at[7];
+  int row, pos;
+  for(row = 0; row < rows; row++){
+    unrank(row, at);
+    printf("%s{", (row % ROWS_PER_LINE == 0) ? "\n  " : " ");
+    for(pos = 0; pos < 7; pos++){
+      printf("%s%d", (pos == 0) ? "" : ",", at[pos]);
+    }
+    printf("}%s", (row < rows - 1) ? "," : "");
+  }
+  printf("};\n\n");
+}
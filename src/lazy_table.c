@@ -0,0 +1,193 @@
+/** File: lazy_table.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the lazy table, which lets the solver answer cubes as
+  * soon as it starts when no table file exists yet.
+  *
+  * Opening a lazy table starts a thread that generates the ranked table (and
+  * saves it, so the next start maps it directly). Until the table is done,
+  * every cube is solved with the bidirectional search (see search.c), which
+  * needs no table and also finds a shortest solution. When the table is done
+  * its pointer is published with a single atomic store, and from then on
+  * every lookup is answered from the table.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lazy_table.h"
+#include "state_table.h"
+#include "search.h"
+#include "cube.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void* generate_in_background(void* arg);
+const uint64_t* ready_table(const LazyTable* lazy_table);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Lazy Table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function opens a lazy table and starts generating the ranked table
+  * in the background. The table can be used right away.
+  * @param save_name The file to save the ranked table to once it is done,
+  *    or NULL to keep it in memory only
+  * @return Pointer to the table (encoding TABLE_LAZY)
+  * @return NULL The table could not be allocated
+  */
+StateTable* open_lazy_table(const char* save_name){
+  StateTable* table = (StateTable*) calloc(1, sizeof(StateTable));
+  LazyTable* lazy_table = (LazyTable*) calloc(1, sizeof(LazyTable));
+  uint64_t* generated = make_ranked_table();
+  if(table == NULL || lazy_table == NULL || generated == NULL){
+    free(table);
+    free(lazy_table);
+    free(generated);
+    return NULL;
+  }
+
+  atomic_init(&lazy_table->ranked_table, NULL);
+  lazy_table->generated = generated;
+  lazy_table->save_name = save_name;
+  if(pthread_create(&lazy_table->thread, NULL, generate_in_background,
+                    lazy_table) != 0){
+    free(table);
+    free(lazy_table);
+    free(generated);
+    return NULL;
+  }
+  table->encoding = TABLE_LAZY;
+  table->data = lazy_table;
+  table->data_size = sizeof(LazyTable);
+  return table;
+}
+
+/** This function waits for the generator to finish and frees a lazy table
+  * @param table The table to close (encoding TABLE_LAZY)
+  */
+void close_lazy_table(StateTable* table){
+  LazyTable* lazy_table = (LazyTable*) table->data;
+  pthread_join(lazy_table->thread, NULL);
+  free(lazy_table->generated);
+  free(lazy_table);
+  free(table);
+}
+
+/** This function checks whether the ranked table has been generated
+  * @param lazy_table The lazy table
+  * @return 1 Cubes are solved with the ranked table
+  * @return 0 Cubes are still solved by search
+  */
+int lazy_table_ready(const LazyTable* lazy_table){
+  return ready_table(lazy_table) != NULL;
+}
+
+/** This function returns the turn used to reach a cube (see get_ranked_turn)
+  * @param lazy_table The lazy table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn (0 when solved).
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist
+  */
+char get_lazy_turn(const LazyTable* lazy_table, int cube){
+  const uint64_t* ranked_table = ready_table(lazy_table);
+  if(ranked_table != NULL) return get_ranked_turn(ranked_table, cube);
+
+  char turn_sequence[SOLUTION_SIZE];
+  if(search_solve_cube_into(cube, turn_sequence) == -1) return -1;
+  return turn_sequence[0];
+}
+
+/** This funciton solves a cube using a lazy table, into a buffer owned by
+  * the caller.
+  * @param cube The cube to be solved
+  * @param lazy_table The lazy table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_lazy_cube_into(int cube, const LazyTable* lazy_table,
+                         char* turn_sequence){
+  const uint64_t* ranked_table = ready_table(lazy_table);
+  if(ranked_table != NULL){
+    return solve_ranked_cube_into(cube, ranked_table, turn_sequence);
+  }
+  return search_solve_cube_into(cube, turn_sequence);
+}
+
+/** This function solves a batch of cubes using a lazy table (see
+  * solve_batch). Once the ranked table is ready the batch is solved together
+  * (see solve_ranked_batch).
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param lazy_table The lazy table
+  * @param solutions n * SOLUTION_SIZE chars, filled with the turns for each 
+  *    cube. An invalid cube is given the single turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t solve_lazy_batch(const int* cubes, size_t n,
+                        const LazyTable* lazy_table, char* solutions){
+  const uint64_t* ranked_table = ready_table(lazy_table);
+  if(ranked_table != NULL){
+    return solve_ranked_batch(cubes, n, ranked_table, solutions);
+  }
+
+  size_t i;
+  size_t solved = 0;
+  for(i = 0; i < n; i++){
+    char* solution = &solutions[i * SOLUTION_SIZE];
+    memset(solution, 0, SOLUTION_SIZE);
+    if(search_solve_cube_into(cubes[i], solution) == -1){
+      memset(solution, 0, SOLUTION_SIZE);
+      solution[0] = -1;
+      continue;
+    }
+    solved++;
+  }
+  return solved;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function is run by the generator thread. It fills the ranked table,
+  * saves it, and then publishes it to the solvers.
+  * @param arg The lazy table
+  * @return NULL
+  */
+void* generate_in_background(void* arg){
+  LazyTable* lazy_table = (LazyTable*) arg;
+  if(!generate_ranked_table(lazy_table->generated)){
+    fprintf(stderr, "The ranked table could not be generated.\n");
+    return NULL; //keep solving by search
+  }
+  if(lazy_table->save_name != NULL &&
+     !save_state_table(lazy_table->save_name, TABLE_RANKED,
+                       lazy_table->generated,
+                       RANKED_TABLE_WORDS * sizeof(uint64_t))){
+    fprintf(stderr, "An error occured while writing to %s.\n",
+            lazy_table->save_name);
+  }
+  //the table is complete before any solver can see it
+  atomic_store_explicit(&lazy_table->ranked_table, lazy_table->generated,
+                        memory_order_release);
+  return NULL;
+}
+
+/** This function returns the ranked table once it has been generated
+  * @param lazy_table The lazy table
+  * @return The ranked table
+  * @return NULL The table is still being generated
+  */
+const uint64_t* ready_table(const LazyTable* lazy_table){
+  return atomic_load_explicit(&lazy_table->ranked_table, memory_order_acquire);
+}
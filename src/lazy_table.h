@@ -0,0 +1,36 @@
+/** File: lazy_table.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file lazy_table.c
+  */
+
+#ifndef LAZY_TABLE_H
+#define LAZY_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "table_file.h"
+
+/** A table that is generated in the background. Until the ranked table is
+  * ready, cubes are solved by search (see search.c).
+  */
+typedef struct LazyTable {
+  _Atomic(const uint64_t*) ranked_table; //NULL until it has been generated
+  uint64_t* generated;                   //the table being generated
+  const char* save_name;                 //where to save it, or NULL
+  pthread_t thread;
+} LazyTable;
+
+//Function Prototypes
+StateTable* open_lazy_table(const char* save_name);
+void close_lazy_table(StateTable* table);
+int lazy_table_ready(const LazyTable* lazy_table);
+char get_lazy_turn(const LazyTable* lazy_table, int cube);
+int solve_lazy_cube_into(int cube, const LazyTable* lazy_table,
+                         char* turn_sequence);
+size_t solve_lazy_batch(const int* cubes, size_t n,
+                        const LazyTable* lazy_table, char* solutions);
+
+#endif
@@ -0,0 +1,278 @@
+/** File: metrics.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the counters and histograms filled by the METRIC_
+  * macros (see metrics.h), and the functions that write them out.
+  *
+  * Every value is a relaxed atomic, so any thread can record into them and
+  * read them without a lock. Latencies are kept in histograms with one bucket
+  * per power of 2 nanoseconds. The breadth first search of a generator
+  * records the size of each level and the time spent expanding it.
+  *
+  * The metrics are written in the Prometheus text format, so the /metrics
+  * endpoint of the server (see server.c) can be scraped as it is.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdarg.h>
+#include <time.h>
+#include <stdatomic.h>
+#include "metrics.h"
+#include "state_table.h"
+
+static _Atomic uint64_t counters[METRIC_COUNTERS];
+static _Atomic uint64_t buckets[METRIC_HISTOGRAMS][METRIC_TIME_BUCKETS];
+static _Atomic uint64_t sums[METRIC_HISTOGRAMS]; //total ns of each histogram
+static _Atomic uint64_t lengths[METRIC_LENGTHS]; //solutions of each length
+
+//the levels of the last breadth first search
+static _Atomic uint64_t level_states[METRIC_MAX_DEPTH];
+static _Atomic uint64_t level_ns[METRIC_MAX_DEPTH];
+static _Atomic int levels;
+
+//the position of a queue based search in its current level (metric_bfs_visit),
+//only used by the thread running the search
+static uint64_t level_started;
+static uint64_t visited;
+static uint64_t level_begin;
+static uint64_t level_end;
+
+static const char* counter_names[METRIC_COUNTERS] = {
+  "solver_get_turn_calls_total",
+  "solver_sorted_lookups_total",
+  "solver_sorted_probes_total",
+  "solver_solves_total",
+  "solver_invalid_cubes_total",
+  "solver_table_loads_total",
+  "solver_table_load_seconds_total",
+  "solver_table_decode_seconds_total"
+};
+static const char* histogram_names[METRIC_HISTOGRAMS] = {
+  "solver_get_turn_seconds",
+  "solver_solve_seconds",
+  "solver_solve_batch_seconds"
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void append_text(char* out, size_t size, size_t* used, const char* format,
+                 ...);
+uint64_t load_relaxed(_Atomic uint64_t* value);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Metric Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function reads the monotonic clock
+  * @return The time in nanoseconds
+  */
+uint64_t metric_clock(){
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/** This function adds to a counter
+  * @param counter The counter (METRIC_GET_TURN_CALLS...)
+  * @param value The amount to add
+  */
+void metric_add(int counter, uint64_t value){
+  atomic_fetch_add_explicit(&counters[counter], value, memory_order_relaxed);
+}
+
+/** This function records a latency in a histogram. Bucket b counts the
+  * latencies below 2^b ns (the last bucket also counts everything above).
+  * @param histogram The histogram (METRIC_GET_TURN_NS...)
+  * @param ns The latency in nanoseconds
+  */
+void metric_observe(int histogram, uint64_t ns){
+  int bucket = (ns == 0) ? 0 : 64 - __builtin_clzll(ns);
+  if(bucket >= METRIC_TIME_BUCKETS) bucket = METRIC_TIME_BUCKETS - 1;
+  atomic_fetch_add_explicit(&buckets[histogram][bucket], 1,
+                            memory_order_relaxed);
+  atomic_fetch_add_explicit(&sums[histogram], ns, memory_order_relaxed);
+}
+
+/** This function records one solved cube
+  * @param length The number of turns in its solution (-1 an invalid cube)
+  */
+void metric_solved(int length){
+  if(length < 0 || length >= METRIC_LENGTHS){
+    metric_add(METRIC_INVALID_CUBES, 1);
+    return;
+  }
+  metric_add(METRIC_SOLVES, 1);
+  atomic_fetch_add_explicit(&lengths[length], 1, memory_order_relaxed);
+}
+
+/** This function records every cube of a solved batch
+  * @param solutions n * SOLUTION_SIZE chars, as filled by solve_batch
+  * @param n The number of cubes
+  */
+void metric_batch(const char* solutions, size_t n){
+  size_t i;
+  for(i = 0; i < n; i++){
+    const char* solution = &solutions[i * SOLUTION_SIZE];
+    int length = 0;
+    if(solution[0] == -1) length = -1;
+    else while(length < SOLUTION_SIZE - 1 && solution[length] != 0) length++;
+    metric_solved(length);
+  }
+}
+
+/** This function starts recording the levels of a breadth first search
+  * (from the solved cube, the only cube at depth 0)
+  */
+void metric_bfs_begin(){
+  atomic_store_explicit(&levels, 0, memory_order_relaxed);
+  level_started = metric_clock();
+  visited = 0;
+  level_begin = 0;
+  level_end = 1;
+}
+
+/** This function records the level of a breadth first search that was just
+  * expanded, and starts timing the next one.
+  * @param states The number of cubes in the level
+  */
+void metric_bfs_level(uint64_t states){
+  uint64_t now = metric_clock();
+  int depth = atomic_load_explicit(&levels, memory_order_relaxed);
+  if(depth < METRIC_MAX_DEPTH){
+    atomic_store_explicit(&level_states[depth], states, memory_order_relaxed);
+    atomic_store_explicit(&level_ns[depth], now - level_started,
+                          memory_order_relaxed);
+    atomic_store_explicit(&levels, depth + 1, memory_order_relaxed);
+  }
+  level_started = now;
+}
+
+/** This function follows a breadth first search that expands one cube at a
+  * time from a queue. Cubes leave the queue in order of depth, so a level is
+  * finished when every cube discovered before it started has been expanded.
+  * @param discovered The number of cubes discovered so far (and queued)
+  */
+void metric_bfs_visit(uint64_t discovered){
+  visited++;
+  if(visited == level_end){
+    metric_bfs_level(level_end - level_begin);
+    level_begin = level_end;
+    level_end = discovered;
+  }
+}
+
+/** This function writes out every metric in the Prometheus text format
+  * @param out Where to write the text
+  * @param size The size of out (METRICS_TEXT_SIZE is enough)
+  * @return The number of chars written
+  */
+size_t format_metrics(char* out, size_t size){
+  size_t used = 0;
+  if(!METRICS_ENABLED){
+    append_text(out, size, &used, "# the solver was built without metrics "
+                "(make METRICS=1)\n");
+    return used;
+  }
+
+  int i, b;
+  for(i = 0; i < METRIC_COUNTERS; i++){
+    uint64_t value = load_relaxed(&counters[i]);
+    append_text(out, size, &used, "# TYPE %s counter\n", counter_names[i]);
+    if(i == METRIC_TABLE_LOAD_NS || i == METRIC_TABLE_DECODE_NS)
+      append_text(out, size, &used, "%s %.9f\n", counter_names[i],
+                  value / 1e9);
+    else
+      append_text(out, size, &used, "%s %llu\n", counter_names[i],
+                  (unsigned long long) value);
+  }
+
+  for(i = 0; i < METRIC_HISTOGRAMS; i++){
+    const char* name = histogram_names[i];
+    uint64_t count = 0;
+    append_text(out, size, &used, "# TYPE %s histogram\n", name);
+    for(b = 0; b < METRIC_TIME_BUCKETS; b++){
+      count += load_relaxed(&buckets[i][b]);
+      if(b < METRIC_TIME_BUCKETS - 1)
+        append_text(out, size, &used, "%s_bucket{le=\"%g\"} %llu\n", name,
+                    (double) (1ULL << b) / 1e9, (unsigned long long) count);
+    }
+    append_text(out, size, &used, "%s_bucket{le=\"+Inf\"} %llu\n", name,
+                (unsigned long long) count);
+    append_text(out, size, &used, "%s_sum %.9f\n%s_count %llu\n", name,
+                load_relaxed(&sums[i]) / 1e9, name,
+                (unsigned long long) count);
+  }
+
+  append_text(out, size, &used, "# TYPE solver_solution_length histogram\n");
+  uint64_t solved = 0;
+  uint64_t turns = 0;
+  for(b = 0; b < METRIC_LENGTHS; b++){
+    uint64_t count = load_relaxed(&lengths[b]);
+    solved += count;
+    turns += count * b;
+    append_text(out, size, &used, "solver_solution_length_bucket{le=\"%d\"} "
+                "%llu\n", b, (unsigned long long) solved);
+  }
+  append_text(out, size, &used, "solver_solution_length_bucket{le=\"+Inf\"} "
+              "%llu\nsolver_solution_length_sum %llu\n"
+              "solver_solution_length_count %llu\n",
+              (unsigned long long) solved, (unsigned long long) turns,
+              (unsigned long long) solved);
+
+  int depths = atomic_load_explicit(&levels, memory_order_relaxed);
+  append_text(out, size, &used, "# TYPE solver_bfs_level_states gauge\n");
+  for(i = 0; i < depths; i++){
+    append_text(out, size, &used, "solver_bfs_level_states{depth=\"%d\"} "
+                "%llu\n", i,
+                (unsigned long long) load_relaxed(&level_states[i]));
+  }
+  append_text(out, size, &used, "# TYPE solver_bfs_level_seconds gauge\n");
+  for(i = 0; i < depths; i++){
+    append_text(out, size, &used, "solver_bfs_level_seconds{depth=\"%d\"} "
+                "%.9f\n", i, load_relaxed(&level_ns[i]) / 1e9);
+  }
+  return used;
+}
+
+/** This function writes out every metric (see format_metrics)
+  * @param out The stream to write to
+  */
+void print_metrics(FILE* out){
+  char text[METRICS_TEXT_SIZE];
+  fwrite(text, 1, format_metrics(text, sizeof(text)), out);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function appends formatted text to a buffer, keeping it terminated
+  * and never writing past its end.
+  * @param out The buffer
+  * @param size The size of out
+  * @param used The number of chars already in out (updated)
+  * @param format The printf format of the text
+  */
+void append_text(char* out, size_t size, size_t* used, const char* format,
+                 ...){
+  if(*used + 1 >= size) return;
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(out + *used, size - *used, format, args);
+  va_end(args);
+  if(written < 0) return;
+  *used += ((size_t) written < size - *used) ? (size_t) written
+                                             : size - *used - 1;
+}
+
+/** This function reads a metric
+  * @param value The metric
+  * @return Its value
+  */
+uint64_t load_relaxed(_Atomic uint64_t* value){
+  return atomic_load_explicit(value, memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+/** File: metrics.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the instrumentation macros and the function prototypes
+  * for the file metrics.c
+  *
+  * The instrumentation is only compiled in when SOLVER_METRICS is defined
+  * (make METRICS=1). Otherwise every METRIC_ macro expands to nothing and its
+  * arguments are never evaluated, so the hot paths are the same as before.
+  */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_TEXT_SIZE 16384 //enough for format_metrics
+#define METRIC_MAX_DEPTH 16 //breadth first search levels recorded
+#define METRIC_TIME_BUCKETS 32 //latency buckets, one per power of 2 ns
+#define METRIC_LENGTHS 15 //solution lengths recorded (0 - 14 turns)
+
+//the counters
+enum {
+  METRIC_GET_TURN_CALLS,  //turns looked up in a table, by any solver
+  METRIC_SORTED_LOOKUPS,  //binary searches of a sorted table
+  METRIC_SORTED_PROBES,   //entries read by those searches
+  METRIC_SOLVES,          //cubes solved (one at a time or in a batch)
+  METRIC_INVALID_CUBES,   //cubes that could not be solved
+  METRIC_TABLE_LOADS,     //tables opened
+  METRIC_TABLE_LOAD_NS,   //time spent opening them
+  METRIC_TABLE_DECODE_NS, //time spent decoding a table into another format
+  METRIC_COUNTERS
+};
+
+//the latency histograms
+enum {
+  METRIC_GET_TURN_NS,     //table_get_turn
+  METRIC_SOLVE_NS,        //table_solve_cube and table_solve_cube_into
+  METRIC_BATCH_NS,        //solve_batch (the whole batch)
+  METRIC_HISTOGRAMS
+};
+
+#ifdef SOLVER_METRICS
+#define METRICS_ENABLED 1
+#define METRIC_ADD(counter, value) metric_add(counter, value)
+#define METRIC_TIMER(start) uint64_t start = metric_clock()
+#define METRIC_ADD_ELAPSED(counter, start) \
+  metric_add(counter, metric_clock() - (start))
+#define METRIC_OBSERVE_ELAPSED(histogram, start) \
+  metric_observe(histogram, metric_clock() - (start))
+#define METRIC_SOLVED(length) metric_solved(length)
+#define METRIC_BATCH(solutions, n) metric_batch(solutions, n)
+#define METRIC_BFS_BEGIN() metric_bfs_begin()
+#define METRIC_BFS_LEVEL(states) metric_bfs_level(states)
+#define METRIC_BFS_VISIT(discovered) metric_bfs_visit(discovered)
+#else
+#define METRICS_ENABLED 0
+#define METRIC_ADD(counter, value) ((void) 0)
+#define METRIC_TIMER(start)
+#define METRIC_ADD_ELAPSED(counter, start) ((void) 0)
+#define METRIC_OBSERVE_ELAPSED(histogram, start) ((void) 0)
+#define METRIC_SOLVED(length) ((void) 0)
+#define METRIC_BATCH(solutions, n) ((void) 0)
+#define METRIC_BFS_BEGIN() ((void) 0)
+#define METRIC_BFS_LEVEL(states) ((void) 0)
+#define METRIC_BFS_VISIT(discovered) ((void) 0)
+#endif
+
+//Function Prototypes
+uint64_t metric_clock();
+void metric_add(int counter, uint64_t value);
+void metric_observe(int histogram, uint64_t ns);
+void metric_solved(int length);
+void metric_batch(const char* solutions, size_t n);
+void metric_bfs_begin();
+void metric_bfs_level(uint64_t states);
+void metric_bfs_visit(uint64_t discovered);
+size_t format_metrics(char* out, size_t size);
+void print_metrics(FILE* out);
+
+#endif
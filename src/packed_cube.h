@@ -0,0 +1,27 @@
+/** File: packed_cube.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file packed_cube.c
+  */
+
+#ifndef PACKED_CUBE_H
+#define PACKED_CUBE_H
+
+#include <stdint.h>
+
+/** A cube packed into 64 bits: byte p describes position p (0 - 7).
+  *   bits 0 - 2: the piece in the position
+  *   bits 3 - 4: the orientation of the piece (0 - 2)
+  */
+typedef uint64_t PackedCube;
+
+#define PACKED_INVALID (~((PackedCube) 0)) //not a cube
+
+//Function Prototypes
+int init_packed_moves();
+PackedCube pack_cube(int cube);
+int unpack_cube(PackedCube packed);
+PackedCube rotate_packed(PackedCube packed, int turn);
+int rank_packed(PackedCube packed);
+
+#endif
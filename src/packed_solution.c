@@ -0,0 +1,60 @@
+/** File: packed_solution.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file converts between the turn sequences written by the solvers
+  * (one char per turn, ending with 0) and packed solutions (see
+  * packed_solution.h), which hold a whole solution in one 64 bit word.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "packed_solution.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~ Packed Solution Functions ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function packs a turn sequence into a packed solution
+  * @param turn_sequence The turns, as returned by solve_cube (-1 when invalid)
+  * @return The packed solution
+  * @return PACKED_SOLUTION_INVALID The cube was invalid, or the sequence has
+  *    more than 14 turns
+  */
+PackedSolution pack_solution(const char* turn_sequence){
+  PackedSolution solution = 0;
+  int count;
+  for(count = 0; turn_sequence[count] != 0; count++){
+    if(count == PACKED_SOLUTION_TURNS || turn_sequence[count] < 1 ||
+       turn_sequence[count] > 6) return PACKED_SOLUTION_INVALID;
+    solution |= ((PackedSolution) turn_sequence[count]) <<
+                (SOLUTION_LENGTH_BITS + (SOLUTION_TURN_BITS * count));
+  }
+  return solution | count;
+}
+
+/** This function unpacks a packed solution into a turn sequence
+  * @param solution The packed solution
+  * @param turn_sequence PACKED_SOLUTION_TURNS + 1 chars, filled with the turns
+  *    followed by the terminator (0), or the single turn -1 when the cube was
+  *    invalid
+  * @return The number of turns
+  * @return -1 The cube was invalid
+  */
+int unpack_solution(PackedSolution solution, char* turn_sequence){
+  int length = solution_length(solution);
+  if(length > PACKED_SOLUTION_TURNS){
+    turn_sequence[0] = -1;
+    turn_sequence[1] = 0;
+    return -1;
+  }
+  PackedSolution turns = solution >> SOLUTION_LENGTH_BITS;
+  int i;
+  for(i = 0; i < length; i++){
+    turn_sequence[i] = turns & 0x07;
+    turns >>= SOLUTION_TURN_BITS;
+  }
+  turn_sequence[length] = 0;
+  return length;
+}
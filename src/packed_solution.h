@@ -0,0 +1,33 @@
+/** File: packed_solution.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the packed solution type and the function prototypes
+  * for the file packed_solution.c
+  */
+
+#ifndef PACKED_SOLUTION_H
+#define PACKED_SOLUTION_H
+
+#include <stdint.h>
+
+/** A solution packed into 64 bits:
+  *   bits 0 - 3: the number of turns (0 - 14)
+  *   bits 4 - 45: the turns, 3 bits each, the first turn in the lowest bits
+  * The turns use the turn codes of cube.h, so the solved cube is the
+  * solution 0.
+  */
+typedef uint64_t PackedSolution;
+
+#define SOLUTION_LENGTH_BITS 4
+#define SOLUTION_TURN_BITS 3
+#define PACKED_SOLUTION_TURNS 14 //longest solution (SOLUTION_SIZE - 1)
+#define PACKED_SOLUTION_INVALID ((PackedSolution) 0x0F) //an invalid cube
+#define solution_length(solution) ((int) ((solution) & 0x0F))
+#define solution_turn(solution, i) ((char) (((solution) >> \
+  (SOLUTION_LENGTH_BITS + (SOLUTION_TURN_BITS * (i)))) & 0x07))
+
+//Function Prototypes
+PackedSolution pack_solution(const char* turn_sequence);
+int unpack_solution(PackedSolution solution, char* turn_sequence);
+
+#endif
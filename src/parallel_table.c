@@ -0,0 +1,417 @@
+/** File: parallel_table.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the parallel generator for the ranked table, and for
+  * the tables of the other puzzles (see puzzle.c).
+  *
+  * The breadth first search is level-synchronous: every cube at depth d
+  * (the frontier) is expanded across the threads before any cube at depth
+  * d + 1 is. Threads claim a newly discovered cube by atomically swapping
+  * its turn from UNVISITED, so each cube enters the next frontier once.
+  *
+  * A cube at depth d + 1 can often be reached from several cubes at depth d,
+  * and the thread that claims it first depends on timing. So that the table
+  * is the same on every run, a second pass sets each new cube to the smallest
+  * turn that leads back to the frontier. (The sequential generator in
+  * state_table.c keeps the first turn in queue order instead, so the tables
+  * differ, but every solution in both is optimal.)
+  *
+  * A puzzle table is generated the same way, over the states of the puzzle
+  * and with its moves: it holds 4 bit move codes instead of 3 bit turns, and
+  * its moves turn the states one at a time (see puzzle_move) instead of the
+  * blocks of ranks turned together for the ranked table.
+  *
+  * Each level is given room for the cubes it can discover (one per move for
+  * each cube of the frontier, and no more than are left unvisited) from one
+  * of two arenas, used in turn and reset once the level they hold is
+  * expanded. At most two levels are held at a time, instead of two buffers
+  * with room for every cube.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "parallel_table.h"
+#include "state_table.h"
+#include "puzzle.h"
+#include "cube.h"
+#include "metrics.h"
+#include "arena.h"
+
+#define LOCAL_FRONTIER 1024 //new cubes a thread collects before publishing
+#define MOVE_BLOCK 64 //cubes of the frontier turned together
+
+typedef struct Level {
+  uint64_t* table;        //the ranked table, or the codes of a puzzle table
+  const Puzzle* puzzle;   //the puzzle, or NULL for the ranked table
+  int bits;               //bits of each entry of the table (3 or 4)
+  uint64_t* in_frontier;  //bit map of the cubes at depth d
+  const int* frontier;    //the cubes at depth d
+  size_t frontier_size;
+  int* next;              //the cubes at depth d + 1
+  size_t next_size;       //updated atomically
+  int threads;
+} Level;
+
+typedef struct Slice {
+  Level* level;
+  int thread;
+} Slice;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+size_t breadth_first(Level* level, int start, int states);
+int run_threads(Level* level, void* (*phase)(void*));
+void* expand_slice(void* arg);
+void expand_ranks(Level* level, size_t start, size_t end, int* found,
+                  int* found_size);
+void expand_states(Level* level, size_t start, size_t end, int* found,
+                   int* found_size);
+void add_found(Level* level, int* found, int* found_size, int state);
+void* choose_turns_slice(void* arg);
+int claim_rank(const Level* level, int rank, char turn);
+void store_turn(const Level* level, int rank, char turn);
+void slice_bounds(const Slice* slice, size_t size, size_t* start, size_t* end);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Generator Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** Fills an empty ranked table with a breadth first search from the solved
+  * cube, expanding each depth across several threads.
+  * @param ranked_table The ranked table to be filled
+  * @param threads The number of threads to use
+  * @return 1 The table was completely filled
+  * @return 0 The table was not completely filled
+  */
+int generate_ranked_table_parallel(uint64_t* ranked_table, int threads){
+  memset(ranked_table, 0xFF, RANKED_TABLE_WORDS * sizeof(uint64_t));
+
+  Level level;
+  level.table = ranked_table;
+  level.puzzle = NULL;
+  level.bits = 3;
+  level.threads = threads;
+  size_t count = breadth_first(&level, rank_cube(SOLVED_CUBE),
+                               NUMBER_OF_CUBES);
+
+  //clear the unused top bit of every word
+  int i;
+  for(i = 0; i < RANKED_TABLE_WORDS; i++){
+    ranked_table[i] &= ~(((uint64_t) 1) << 63);
+  }
+  return count == NUMBER_OF_CUBES;
+}
+
+/** Fills the codes of an empty puzzle table with a breadth first search from
+  * the solved state of the puzzle, expanding each depth across several
+  * threads. The states the moves cannot reach are left PUZZLE_UNVISITED.
+  * @param puzzle The puzzle
+  * @param entries The codes of the table (see make_puzzle_table)
+  * @param threads The number of threads to use
+  * @return The number of states that were reached
+  * @return 0 Out of memory
+  */
+size_t generate_puzzle_table_parallel(const Puzzle* puzzle, uint64_t* entries,
+                                      int threads){
+  int states = puzzle_states(puzzle);
+  memset(entries, 0xFF, ((states + PUZZLE_ENTRIES_PER_WORD - 1) /
+                         PUZZLE_ENTRIES_PER_WORD) * sizeof(uint64_t));
+
+  Level level;
+  level.table = entries;
+  level.puzzle = puzzle;
+  level.bits = 4;
+  level.threads = threads;
+  return breadth_first(&level, puzzle_state(puzzle, SOLVED_CUBE), states);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function runs the breadth first search, one depth at a time, on a
+  * table where every entry is unvisited.
+  * @param level The table, the puzzle and the threads (the rest is filled)
+  * @param start The solved state, where the search starts
+  * @param states The number of states
+  * @return The number of states that were reached
+  * @return 0 Out of memory
+  */
+size_t breadth_first(Level* level, int start, int states){
+  if(level->threads < 1) level->threads = 1;
+  int moves = (level->puzzle == NULL) ? 6 : level->puzzle->move_count;
+  size_t bitmap_words = ((size_t) states + 63) / 64;
+  Arena* arenas[2] = {create_arena(0), create_arena(0)}; //one per level
+  uint64_t* in_frontier = (uint64_t*) calloc(bitmap_words, sizeof(uint64_t));
+  int* frontier = NULL;
+  if(arenas[0] != NULL) frontier = (int*) arena_alloc(arenas[0], sizeof(int));
+  if(arenas[1] == NULL || in_frontier == NULL || frontier == NULL){
+    free_arena(arenas[0]);
+    free_arena(arenas[1]);
+    free(in_frontier);
+    return 0;
+  }
+
+  frontier[0] = start;
+  store_turn(level, start, 0x00);
+  level->in_frontier = in_frontier;
+  level->frontier_size = 1;
+  size_t count = 1;
+  int filled = 1;
+  int depth = 0;
+  METRIC_BFS_BEGIN();
+
+  while(level->frontier_size > 0 && filled){
+    size_t i;
+    for(i = 0; i < level->frontier_size; i++){
+      in_frontier[frontier[i] / 64] |= ((uint64_t) 1) << (frontier[i] % 64);
+    }
+
+    //the next depth goes in the arena that held the depth before this one
+    Arena* next_arena = arenas[(depth + 1) % 2];
+    size_t room = level->frontier_size * moves;
+    if(room > states - count) room = states - count;
+    arena_reset(next_arena);
+    int* next = (int*) arena_alloc(next_arena, (room + 1) * sizeof(int));
+    if(next == NULL){
+      filled = 0;
+      break;
+    }
+    level->frontier = frontier;
+    level->next = next;
+    level->next_size = 0;
+
+    filled = run_threads(level, expand_slice) &&
+             run_threads(level, choose_turns_slice);
+    METRIC_BFS_LEVEL(level->frontier_size);
+
+    memset(in_frontier, 0, bitmap_words * sizeof(uint64_t));
+    count += level->next_size;
+
+    //the next depth becomes the frontier
+    frontier = next;
+    level->frontier_size = level->next_size;
+    depth++;
+  }
+
+  free_arena(arenas[0]);
+  free_arena(arenas[1]);
+  free(in_frontier);
+  return filled ? count : 0;
+}
+
+/** This function runs one phase of a level on every thread, and waits for
+  * them all to finish.
+  * @param level The level being expanded
+  * @param phase The function each thread runs on its slice
+  * @return 1 The phase finished
+  * @return 0 A thread could not be created
+  */
+int run_threads(Level* level, void* (*phase)(void*)){
+  pthread_t thread_ids[level->threads];
+  Slice slices[level->threads];
+  int started = 0;
+  int i;
+  for(i = 0; i < level->threads; i++){
+    slices[i].level = level;
+    slices[i].thread = i;
+    if(i == 0) continue; //the calling thread takes the first slice
+    if(pthread_create(&thread_ids[i], NULL, phase, &slices[i]) != 0) break;
+    started++;
+  }
+  phase(&slices[0]);
+  for(i = 1; i <= started; i++){
+    pthread_join(thread_ids[i], NULL);
+  }
+  return started == level->threads - 1;
+}
+
+/** This function expands a slice of the frontier. Every cube that has not
+  * been visited is claimed and added to the next frontier.
+  * @param arg The Slice to expand
+  * @return NULL
+  */
+void* expand_slice(void* arg){
+  Slice* slice = (Slice*) arg;
+  Level* level = slice->level;
+  int found[LOCAL_FRONTIER];
+  int found_size = 0;
+
+  size_t start, end;
+  slice_bounds(slice, level->frontier_size, &start, &end);
+  if(level->puzzle == NULL){
+    expand_ranks(level, start, end, found, &found_size);
+  }else{
+    expand_states(level, start, end, found, &found_size);
+  }
+  size_t at = __atomic_fetch_add(&level->next_size, found_size,
+                                 __ATOMIC_RELAXED);
+  memcpy(&level->next[at], found, found_size * sizeof(int));
+  return NULL;
+}
+
+/** This function expands part of the frontier of the ranked table
+  * @param level The level being expanded
+  * @param start The first cube of the frontier to expand
+  * @param end The cube of the frontier after the last one to expand
+  * @param found LOCAL_FRONTIER new cubes, not yet added to the next frontier
+  * @param found_size The number of new cubes in found
+  */
+void expand_ranks(Level* level, size_t start, size_t end, int* found,
+                  int* found_size){
+  size_t i;
+  for(i = start; i < end; i += MOVE_BLOCK){
+    //turn a block of the frontier at once
+    int turned[6][MOVE_BLOCK];
+    size_t size = (end - i < MOVE_BLOCK) ? end - i : MOVE_BLOCK;
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      memcpy(turned[rotation], &level->frontier[i], size * sizeof(int));
+      rotate_rank_batch(turned[rotation], size, rotation);
+    }
+
+    size_t j;
+    for(j = 0; j < size; j++){
+      //turn n is reached by rotation (n - 1) ^ 1 (FC, FCC, LC, LCC, TC, TCC)
+      char turn;
+      for(turn = 0x01; turn <= 0x06; turn++){
+        int rank = turned[(turn - 1) ^ 1][j];
+        if(claim_rank(level, rank, turn)){
+          add_found(level, found, found_size, rank);
+        }
+      }
+    }
+  }
+}
+
+/** This function expands part of the frontier of a puzzle table
+  * @param level The level being expanded
+  * @param start The first state of the frontier to expand
+  * @param end The state of the frontier after the last one to expand
+  * @param found LOCAL_FRONTIER new states, not yet added to the next frontier
+  * @param found_size The number of new states in found
+  */
+void expand_states(Level* level, size_t start, size_t end, int* found,
+                   int* found_size){
+  const Puzzle* puzzle = level->puzzle;
+  size_t i;
+  for(i = start; i < end; i++){
+    int move;
+    for(move = 0; move < puzzle->move_count; move++){
+      //the state is solved by the move that undoes this one
+      int state = puzzle_move(puzzle, level->frontier[i], move);
+      if(claim_rank(level, state, puzzle->moves[move].inverse + 1)){
+        add_found(level, found, found_size, state);
+      }
+    }
+  }
+}
+
+/** This function adds a new cube to those a thread found, and publishes
+  * them to the next frontier when there are LOCAL_FRONTIER of them.
+  * @param level The level being expanded
+  * @param found The new cubes
+  * @param found_size The number of new cubes in found
+  * @param state The new cube
+  */
+void add_found(Level* level, int* found, int* found_size, int state){
+  found[(*found_size)++] = state;
+  if(*found_size == LOCAL_FRONTIER){ //publish a block of new cubes
+    size_t at = __atomic_fetch_add(&level->next_size, *found_size,
+                                   __ATOMIC_RELAXED);
+    memcpy(&level->next[at], found, *found_size * sizeof(int));
+    *found_size = 0;
+  }
+}
+
+/** This function sets each cube in a slice of the next frontier to the
+  * smallest turn that leads back to the frontier, so that the table does not
+  * depend on which thread claimed the cube first.
+  * @param arg The Slice of the next frontier
+  * @return NULL
+  */
+void* choose_turns_slice(void* arg){
+  Slice* slice = (Slice*) arg;
+  Level* level = slice->level;
+  const Puzzle* puzzle = level->puzzle;
+  int moves = (puzzle == NULL) ? 6 : puzzle->move_count;
+
+  size_t start, end, i;
+  slice_bounds(slice, level->next_size, &start, &end);
+  for(i = start; i < end; i++){
+    int rank = level->next[i];
+    int perm = rank / NUMBER_OF_ORIENTATIONS;
+    int orient = rank % NUMBER_OF_ORIENTATIONS;
+
+    //turn n is undone by rotation n - 1 (move n - 1 of a puzzle)
+    char turn;
+    for(turn = 0x01; turn <= moves; turn++){
+      int parent = (puzzle != NULL) ? puzzle_move(puzzle, rank, turn - 1) :
+                   (perm_move_table[perm][turn - 1] * NUMBER_OF_ORIENTATIONS) +
+                   orient_move_table[orient][turn - 1];
+      if(level->in_frontier[parent / 64] & (((uint64_t) 1) << (parent % 64)))
+        break;
+    }
+    store_turn(level, rank, turn);
+  }
+  return NULL;
+}
+
+/** This function atomically claims an unvisited cube in the table
+  * @param level The level (the table and the bits of its entries)
+  * @param rank The rank of the cube (the state of a puzzle)
+  * @param turn The turn used to reach the cube
+  * @return 1 The cube was unvisited and now holds the turn
+  * @return 0 The cube had already been visited
+  */
+int claim_rank(const Level* level, int rank, char turn){
+  uint64_t unvisited = (((uint64_t) 1) << level->bits) - 1;
+  int per_word = 64 / level->bits;
+  int shift = (rank % per_word) * level->bits;
+  uint64_t* word = &level->table[rank / per_word];
+  uint64_t old_word = __atomic_load_n(word, __ATOMIC_RELAXED);
+  do{
+    if(((old_word >> shift) & unvisited) != unvisited) return 0;
+  }while(!__atomic_compare_exchange_n(word, &old_word,
+         old_word & ~((unvisited ^ (uint64_t) turn) << shift), 1,
+         __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  return 1;
+}
+
+/** This function atomically stores a turn in the table (other threads may be
+  * storing turns in the same word)
+  * @param level The level (the table and the bits of its entries)
+  * @param rank The rank of the cube (the state of a puzzle)
+  * @param turn The turn used to reach the cube
+  */
+void store_turn(const Level* level, int rank, char turn){
+  uint64_t mask = (((uint64_t) 1) << level->bits) - 1;
+  int per_word = 64 / level->bits;
+  int shift = (rank % per_word) * level->bits;
+  uint64_t* word = &level->table[rank / per_word];
+  uint64_t old_word = __atomic_load_n(word, __ATOMIC_RELAXED);
+  uint64_t new_word;
+  do{
+    if(((old_word >> shift) & mask) == (uint64_t) turn) return; //already set
+    new_word = (old_word & ~(mask << shift)) | (((uint64_t) turn) << shift);
+  }while(!__atomic_compare_exchange_n(word, &old_word, new_word, 1,
+         __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/** This function splits a range evenly between the threads
+  * @param slice The thread's slice
+  * @param size The size of the range
+  * @param start Filled with the first index of the slice
+  * @param end Filled with the index after the slice
+  */
+void slice_bounds(const Slice* slice, size_t size, size_t* start, size_t* end){
+  int threads = slice->level->threads;
+  *start = (size * slice->thread) / threads;
+  *end = (size * (slice->thread + 1)) / threads;
+}
@@ -0,0 +1,19 @@
+/** File: parallel_table.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file parallel_table.c
+  */
+
+#ifndef PARALLEL_TABLE_H
+#define PARALLEL_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "puzzle.h"
+
+//Function Prototypes
+int generate_ranked_table_parallel(uint64_t* ranked_table, int threads);
+size_t generate_puzzle_table_parallel(const Puzzle* puzzle, uint64_t* entries,
+                                      int threads);
+
+#endif
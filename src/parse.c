@@ -0,0 +1,314 @@
+/** File: parse.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  *
+  * This file contains the functions that convert between the colors of a cube
+  * (as entered by the user) and the integer representation of the cube.
+  * They were moved from solver.c so that every solving mode can share them.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "cube.h"
+#include "parse.h"
+#include "packed_cube.h"
+#include "packed_solution.h"
+
+#define c21_6 (85766121)
+#define c21_5 (4084101)
+#define c21_4 (194481)
+#define c21_3 (9261)
+#define c21_2 (441)
+#define c21_1 (21)
+#define c21_0 (1)
+
+#define NO_COLOR 6 //color code of a character that is not a color
+#define COLOR_KEYS (7 * 7 * 7) //three color codes (0 - 6)
+
+extern char state_table0356[21][3];
+extern char state_table1247[21][3];
+
+//powers of 21 indexed by piece
+static int c21[7] = {c21_0, c21_1, c21_2, c21_3, c21_4, c21_5, c21_6};
+
+//the colors of each piece (top/bottom, front/back, left/right when solved)
+static const char* piece_colors[7] = {"owg", "rwg", "owb", "rwb", "oyg", 
+                                      "ryg", "oyb"};
+
+//the buffer index of the top/bottom, front/back and left/right face of each
+//position
+static const char corner_faces[7][3] = {
+  {2, 8, 5}, {20, 10, 7}, {3, 9, 12}, {21, 11, 14}, {0, 17, 4}, {22, 19, 6},
+  {1, 16, 13}};
+
+/** The following tables are filled by init_parse_tables
+  * color_codes[c]: the code (0 - 5) of the color character c, or NO_COLOR
+  * corner_codes[pos][key]: (piece << 5) | state for the colors of a corner 
+  *   at position pos, keyed on (code1 * 49) + (code2 * 7) + code3, or -1 when
+  *   no piece has those colors in that position
+  */
+static char color_codes[256];
+static short corner_codes[7][COLOR_KEYS];
+static pthread_once_t parse_tables_once = PTHREAD_ONCE_INIT;
+
+void fill_parse_tables();
+int color_key(char color1, char color2, char color3);
+
+/** This function converts a line of the stream into a cube.
+  * @param line The line (24 colors, or an integer)
+  * @return The integer representation of the cube
+  * @return -1 The line does not hold a valid cube
+  */
+int parse_line(char* line){
+  while(*line == ' ' || *line == '\t') line++;
+
+  if(*line >= '0' && *line <= '9'){ //integer representation
+    char* end;
+    long cube = strtol(line, &end, 0);
+    while(*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n') end++;
+    if(*end != '\0' || cube < 0 || cube > 0x7FFFFFFF) return -1;
+    return (int) cube;
+  }
+
+  char buffer[BUFF_SIZE];
+  int count = 0;
+  for(; *line != '\0' && *line != '\n' && *line != '\r'; line++){
+    switch(*line){
+      case ' ': //ignore spaces
+        break;
+      case 'o':
+      case 'r':
+      case 'w':
+      case 'y':
+      case 'g':
+      case 'b':
+        if(count == BUFF_SIZE) return -1; //too many colors
+        buffer[count++] = *line;
+        break;
+      default:
+        return -1;
+    }
+  }
+  if(count != BUFF_SIZE) return -1;
+
+  int cube = compress(buffer);
+  return (cube < 0) ? -1 : cube;
+}
+
+/** This function converts the name of a turn into its code. Both the names
+  * of format_solution (FCC FC LCC LC TCC TC) and the standard notation
+  * (F' F L' L U' U) are accepted.
+  * @param text The name, which may be followed by spaces or the line end
+  * @return The turn (1 - 6, as in the solutions of solve_cube)
+  * @return -1 The text is not the name of a turn
+  */
+int parse_turn(const char* text){
+  static const char* turn_names[12] = {"FCC", "FC", "LCC", "LC", "TCC", "TC",
+                                       "F'", "F", "L'", "L", "U'", "U"};
+  while(*text == ' ' || *text == '\t') text++;
+  size_t length = 0;
+  while(text[length] != '\0' && text[length] != ' ' && text[length] != '\t' &&
+        text[length] != '\r' && text[length] != '\n') length++;
+  const char* end = text + length;
+  while(*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n') end++;
+  if(*end != '\0') return -1;
+
+  int i;
+  for(i = 0; i < 12; i++){
+    if(strlen(turn_names[i]) == length &&
+       strncmp(text, turn_names[i], length) == 0) return (i % 6) + 1;
+  }
+  return -1;
+}
+
+/** This function writes a solution as a line of text
+  * @param out Where to write the line
+  * @param solution The turns, as returned by solve_cube (-1 when invalid)
+  * @return Pointer to the end of the line that was written
+  */
+char* format_solution(char* out, const char* solution){
+  static const char* turn_names[7] = {"", "FCC", "FC", "LCC", "LC", "TCC", 
+                                      "TC"};
+  if(solution[0] == -1){
+    memcpy(out, "INVALID\n", 8);
+    return out + 8;
+  }
+  int i;
+  for(i = 0; solution[i] != 0; i++){
+    if(i > 0) *out++ = ' ';
+    const char* name = turn_names[(int) solution[i]];
+    while(*name != '\0') *out++ = *name++;
+  }
+  *out++ = '\n';
+  return out;
+}
+
+/** This function writes a packed solution as a line of text in the standard
+  * notation (F F' L L' U U', the top face is U). Every turn is copied as 4
+  * bytes from a table and the line is advanced by the length of its name, so
+  * out needs 3 spare bytes (OUTPUT_LINE_SIZE is enough).
+  * @param out Where to write the line
+  * @param solution The packed solution (PACKED_SOLUTION_INVALID when invalid)
+  * @return Pointer to the end of the line that was written
+  */
+char* format_packed_solution(char* out, PackedSolution solution){
+  static const char turn_text[8][4] = {"", "F' ", "F ", "L' ", "L ", "U' ",
+                                       "U ", ""};
+  static const char turn_text_size[8] = {0, 3, 2, 3, 2, 3, 2, 0};
+  int length = solution_length(solution);
+  if(length > PACKED_SOLUTION_TURNS){
+    memcpy(out, "INVALID\n", 8);
+    return out + 8;
+  }
+  if(length == 0){
+    *out = '\n';
+    return out + 1;
+  }
+
+  PackedSolution turns = solution >> SOLUTION_LENGTH_BITS;
+  int i;
+  for(i = 0; i < length; i++){
+    memcpy(out, turn_text[turns & 0x07], 4);
+    out += turn_text_size[turns & 0x07];
+    turns >>= SOLUTION_TURN_BITS;
+  }
+  out[-1] = '\n'; //replaces the space after the last turn
+  return out;
+}
+
+/** This function checks the colors in a buffer of 24 colors
+  * @param buffer The buffer containing the cube colors
+  * @return 0 The colors are valid
+  * @return 1 The buffer does not have 4 of each color
+  * @return 2 The red-yellow-blue corner is not in the bottom-back-right
+  */
+int check_colors(char* buffer){
+  //count colors;
+  char color_count[6] = {0,0,0,0,0,0};
+  int count;
+  for(count = 0; count < BUFF_SIZE; count++){
+    switch(buffer[count]){
+      case 'o':
+        color_count[0]++;
+        break;
+      case 'r':
+        color_count[1]++;
+        break;
+      case 'y':
+        color_count[2]++;
+        break;
+      case 'w':
+        color_count[3]++;
+        break;
+      case 'g':
+        color_count[4]++;
+        break;
+      case 'b':
+        color_count[5]++;
+        break;
+    }
+  }
+
+  //check color count
+  for(count = 0; count < 6; count++){
+    if(color_count[count] != 4) return 1;
+  }
+
+  //check proper orientation (red-yellow-blue in bottom-back-right)
+  if(buffer[15] != 'b' || buffer[18] != 'y' || buffer[23] != 'r') return 2;
+  return 0;
+}
+
+/** This function determines if the cube is in a valid state. Each corner is
+  * found with one load from corner_codes, keyed on its three colors, and the
+  * cube is checked with arithmetic: every piece must appear once, the fixed
+  * corner must be in place, and the orientations must sum to 0 (mod 3).
+  * @param buffer The buffer containing the cube colors
+  * @param return The integer interpretation of the cube
+  * @param return -1 if the cube is not valid
+  * @param return -2 if the cube appears valid but does not exist (a single
+  *   corner is twisted)
+  */
+int compress (char* buffer){
+  init_parse_tables();
+
+  int cube = 0;
+  int pieces = 0; //bit mask of the pieces found
+  int orient_sum = 0;
+  int pos;
+  for(pos = 0; pos < 7; pos++){
+    const char* faces = corner_faces[pos];
+    int code = corner_codes[pos][color_key(buffer[(int) faces[0]], 
+                                           buffer[(int) faces[1]],
+                                           buffer[(int) faces[2]])];
+    if(code == -1) return -1; //not a piece, or not a possible orientation
+
+    int piece = code >> 5;
+    int state = code & 0x1F;
+    pieces |= 1 << piece;
+    orient_sum += state % 3;
+    cube += state * c21[piece];
+  }
+  if(pieces != 0x7F) return -1; //a repeated piece
+  if(buffer[15] != 'b' || buffer[18] != 'y' || buffer[23] != 'r') return -1;
+  if(orient_sum % 3 != 0) return -2;
+  return cube;
+}
+
+/** This function converts a buffer of 24 colors into a packed cube (see
+  * packed_cube.c)
+  * @param buffer The buffer containing the cube colors
+  * @return The packed cube
+  * @return PACKED_INVALID The cube is not valid
+  */
+PackedCube compress_packed(char* buffer){
+  int cube = compress(buffer);
+  if(cube < 0) return PACKED_INVALID;
+  return pack_cube(cube);
+}
+
+/** This function fills the color lookup tables used by compress. The tables
+  * are filled by the first call only (see fill_parse_tables), and every
+  * other thread calling in waits for them, so it is safe to call before
+  * every use from any thread.
+  */
+void init_parse_tables(){
+  pthread_once(&parse_tables_once, fill_parse_tables);
+}
+
+/** This function fills the color lookup tables (see init_parse_tables)
+  */
+void fill_parse_tables(){
+  memset(color_codes, NO_COLOR, sizeof(color_codes));
+  int color;
+  for(color = 0; color < 6; color++){
+    color_codes[(unsigned char) "orwygb"[color]] = color;
+  }
+
+  memset(corner_codes, -1, sizeof(corner_codes));
+  int piece, state;
+  for(piece = 0; piece < 7; piece++){
+    for(state = 0; state < 21; state++){
+      char* order = (piece == 0 || piece == 3 || piece == 5 || piece == 6) ?
+                    state_table0356[state] : state_table1247[state];
+      const char* colors = piece_colors[piece];
+      int key = color_key(colors[(int) order[0]], colors[(int) order[1]],
+                          colors[(int) order[2]]);
+      corner_codes[state / 3][key] = (piece << 5) | state;
+    }
+  }
+}
+
+/** This function combines the colors of a corner into a key of corner_codes
+  * @param color1 The color on the top/bottom
+  * @param color2 The color on the front/back
+  * @param color3 The color on the left/right
+  * @return The key (0 - 342)
+  */
+int color_key(char color1, char color2, char color3){
+  return (color_codes[(unsigned char) color1] * 49) +
+         (color_codes[(unsigned char) color2] * 7) +
+         color_codes[(unsigned char) color3];
+}
@@ -0,0 +1,27 @@
+/** File: parse.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file parse.c
+  */
+
+#ifndef PARSE_H
+#define PARSE_H
+
+#include "packed_cube.h"
+#include "packed_solution.h"
+
+#define BUFF_SIZE 24 //number of colors on a cube
+#define LINE_SIZE 256 //longest line parse_line accepts
+#define OUTPUT_LINE_SIZE 64 //longest line format_solution writes
+
+//Function Prototypes
+void init_parse_tables();
+int check_colors(char* buffer);
+int compress(char* buffer);
+PackedCube compress_packed(char* buffer);
+int parse_line(char* line);
+int parse_turn(const char* text);
+char* format_solution(char* out, const char* solution);
+char* format_packed_solution(char* out, PackedSolution solution);
+
+#endif
@@ -0,0 +1,105 @@
+/** File: pocketsolver.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the functions of libpocketsolver (see pocketsolver.h).
+  * Each one passes straight through to the solver: the tables are loaded
+  * by open_state_table, cubes are read by parse_line and solved by
+  * table_solve_cube_into and solve_batch.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <string.h>
+#include "pocketsolver.h"
+#include "table_file.h"
+#include "state_table.h"
+#include "parse.h"
+#include "cube.h"
+
+#if POCKET_SOLUTION_SIZE != SOLUTION_SIZE || \
+    POCKET_LINE_SIZE != OUTPUT_LINE_SIZE
+#error "pocketsolver.h is out of date with the solver"
+#endif
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~ Pocket Solver Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function maps a table for solving cubes, read-only. Unlike the
+  * solver (see load_state_table), it never writes a table or starts a
+  * thread to generate one: build ranked_table.bin with solver -g first.
+  * @param file_name A table file (of any encoding), or NULL for
+  *    ranked_table.bin in the working directory
+  * @return Pointer to the table
+  * @return NULL The file is missing or is not a valid table
+  */
+PocketTable* pocket_load_table(const char* file_name){
+  return open_state_table(file_name != NULL ? file_name : "ranked_table.bin",
+                          0);
+}
+
+/** This function closes a table
+  * @param table The table (or NULL)
+  */
+void pocket_close_table(PocketTable* table){
+  close_state_table(table);
+}
+
+/** This function converts a cube from text: its 24 colors (o r w y g b, in
+  * the order the solver asks for them, spaces are ignored) or its integer.
+  * @param colors The text, ending with '\0' or a line end
+  * @return The integer representation of the cube
+  * @return -1 The text does not hold a valid cube
+  */
+int pocket_compress(const char* colors){
+  char line[LINE_SIZE];
+  size_t length = strlen(colors);
+  if(length >= LINE_SIZE) return -1;
+  memcpy(line, colors, length + 1);
+  return parse_line(line);
+}
+
+/** This function solves a cube
+  * @param table The table
+  * @param cube The integer representation of the cube
+  * @param solution POCKET_SOLUTION_SIZE chars, filled with the turns
+  * @return The number of turns
+  * @return -1 The cube is invalid
+  */
+int pocket_solve(const PocketTable* table, int cube, char* solution){
+  if(cube < 0 || table_solve_cube_into(table, cube, solution) == -1){
+    solution[0] = -1;
+    solution[1] = 0;
+    return -1;
+  }
+  int length = 0;
+  while(solution[length] != 0) length++;
+  return length;
+}
+
+/** This function solves a batch of cubes (see solve_batch)
+  * @param table The table
+  * @param cubes The cubes
+  * @param n The number of cubes
+  * @param solutions n * POCKET_SOLUTION_SIZE chars, filled with the turns
+  *    of each cube. An invalid cube is given the single turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t pocket_solve_batch(const PocketTable* table, const int* cubes,
+                          size_t n, char* solutions){
+  return solve_batch(cubes, n, table, solutions);
+}
+
+/** This function writes a solution as a line of text, ending with '\n'
+  * (INVALID for an invalid cube). The text is not terminated.
+  * @param out POCKET_LINE_SIZE chars to write the line to
+  * @param solution The solution
+  * @param notation 0 for FCC FC LCC LC TCC TC, 1 for F' F L' L U' U
+  * @return Pointer to the end of the line that was written
+  */
+char* pocket_format_solution(char* out, const char* solution, int notation){
+  if(notation) return format_packed_solution(out, pack_solution(solution));
+  return format_solution(out, solution);
+}
@@ -0,0 +1,43 @@
+/** File: pocketsolver.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file is the interface of libpocketsolver (make lib), for programs
+  * that solve cubes themselves instead of running the solver. It needs no
+  * other header of the solver.
+  *
+  * A cube is an int (see cube.c), and a solution is POCKET_SOLUTION_SIZE
+  * chars holding the turns followed by 0, where the turns are
+  *   1: F'  2: F  3: L'  4: L  5: U'  6: U  (FCC FC LCC LC TCC TC)
+  * A table can be shared by any number of threads.
+  */
+
+#ifndef POCKETSOLVER_H
+#define POCKETSOLVER_H
+
+#include <stddef.h>
+
+#define POCKET_SOLUTION_SIZE 15 //chars of a solution (14 turns, then 0)
+#define POCKET_LINE_SIZE 64 //longest line pocket_format_solution writes
+
+//the only symbols libpocketsolver.so exports
+#if defined(__GNUC__)
+#define POCKET_API __attribute__((visibility("default")))
+#else
+#define POCKET_API
+#endif
+
+typedef struct StateTable PocketTable;
+
+//Function Prototypes
+POCKET_API PocketTable* pocket_load_table(const char* file_name);
+POCKET_API void pocket_close_table(PocketTable* table);
+POCKET_API int pocket_compress(const char* colors);
+POCKET_API int pocket_solve(const PocketTable* table, int cube,
+                            char* solution);
+POCKET_API size_t pocket_solve_batch(const PocketTable* table,
+                                     const int* cubes, size_t n,
+                                     char* solutions);
+POCKET_API char* pocket_format_solution(char* out, const char* solution,
+                                        int notation);
+
+#endif
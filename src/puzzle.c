@@ -0,0 +1,359 @@
+/** File: puzzle.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the variants of the cube (see puzzle.h): the same
+  * pieces, but other move sets or goals. Each one is solved optimally with
+  * its own table, generated by the parallel generator (see parallel_table.c)
+  * and saved in the file:
+  *   <name>_table.bin
+  *
+  * A variant is described by its moves, each a quarter turn made once or
+  * twice, and by the pieces that must be solved. When every piece must be
+  * solved, the states are the ranks of the cubes (3,674,160), and a move set
+  * that cannot reach every cube leaves the rest unvisited. When only some
+  * pieces must be solved (EX: the first layer), the state is the position
+  * and orientation of those pieces alone, 21 states per piece, so the whole
+  * table is far smaller.
+  *
+  * The table holds a 4 bit move code for each state (the move that brings
+  * it one move closer to solved), so up to 9 moves fit with codes to spare.
+  * The file starts with the name of the variant, and the header records the
+  * number of states, so the table of one variant is never used for another.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "puzzle.h"
+#include "parallel_table.h"
+#include "state_table.h"
+#include "cube.h"
+
+#define PUZZLES 4 //variants in the puzzles table
+#define FIRST_LAYER 0x2A //pieces 1, 3 and 5 (with the fixed piece 7)
+
+//each move is a rotation (0 - 5: F' F L' L U' U) made once or twice, and
+//the index of the move that undoes it
+static const Puzzle puzzles[PUZZLES] = {
+  {"qtm", "the whole cube, quarter turns (as solved by the solver)",
+   PUZZLE_ALL_PIECES, 6,
+   {{"F'", 0, 1, 1}, {"F", 1, 1, 0}, {"L'", 2, 1, 3}, {"L", 3, 1, 2},
+    {"U'", 4, 1, 5}, {"U", 5, 1, 4}}},
+  {"htm", "the whole cube, quarter and half turns",
+   PUZZLE_ALL_PIECES, 9,
+   {{"F'", 0, 1, 1}, {"F", 1, 1, 0}, {"F2", 1, 2, 2},
+    {"L'", 2, 1, 4}, {"L", 3, 1, 3}, {"L2", 3, 2, 5},
+    {"U'", 4, 1, 7}, {"U", 5, 1, 6}, {"U2", 5, 2, 8}}},
+  {"fu", "F and U only, quarter and half turns (the <F,U> subgroup)",
+   PUZZLE_ALL_PIECES, 6,
+   {{"F'", 0, 1, 1}, {"F", 1, 1, 0}, {"F2", 1, 2, 2},
+    {"U'", 4, 1, 4}, {"U", 5, 1, 3}, {"U2", 5, 2, 5}}},
+  {"first-layer", "the bottom layer (pieces 1, 3, 5), quarter turns",
+   FIRST_LAYER, 6,
+   {{"F'", 0, 1, 1}, {"F", 1, 1, 0}, {"L'", 2, 1, 3}, {"L", 3, 1, 2},
+    {"U'", 4, 1, 5}, {"U", 5, 1, 4}}}};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+int rotate_pieces(const Puzzle* puzzle, int state, int rotation);
+int table_file_name(const Puzzle* puzzle, char* file_name, size_t size);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Puzzle Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function finds a puzzle by its name
+  * @param name The name (EX: "htm")
+  * @return Pointer to the puzzle
+  * @return NULL There is no puzzle with that name
+  */
+const Puzzle* find_puzzle(const char* name){
+  int i;
+  for(i = 0; i < PUZZLES; i++){
+    if(strcmp(puzzles[i].name, name) == 0) return &puzzles[i];
+  }
+  return NULL;
+}
+
+/** This function returns a puzzle, to list every puzzle
+  * @param index The index of the puzzle (0, 1, 2...)
+  * @return Pointer to the puzzle
+  * @return NULL There are no more puzzles
+  */
+const Puzzle* puzzle_at(int index){
+  return (index >= 0 && index < PUZZLES) ? &puzzles[index] : NULL;
+}
+
+/** This function returns the number of states of a puzzle (some may not be
+  * reachable with its moves)
+  * @param puzzle The puzzle
+  * @return The number of states
+  */
+int puzzle_states(const Puzzle* puzzle){
+  if(puzzle->pieces == PUZZLE_ALL_PIECES) return NUMBER_OF_CUBES;
+  int states = 1;
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    if(puzzle->pieces & (1 << piece)) states *= 21;
+  }
+  return states;
+}
+
+/** This function converts a cube into its state in a puzzle
+  * @param puzzle The puzzle
+  * @param cube The integer representation of the cube
+  * @return The state (0 - puzzle_states(puzzle) - 1)
+  * @return -1 The integer does not represent a reachable cube
+  */
+int puzzle_state(const Puzzle* puzzle, int cube){
+  int rank = rank_cube(cube);
+  if(rank == -1 || puzzle->pieces == PUZZLE_ALL_PIECES) return rank;
+
+  //the states of the pieces, in base 21 (see cube.c)
+  int state = 0;
+  int place = 1;
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    if(puzzle->pieces & (1 << piece)){
+      state += (cube % 21) * place;
+      place *= 21;
+    }
+    cube /= 21;
+  }
+  return state;
+}
+
+/** This function makes a move on a state of a puzzle
+  * @param puzzle The puzzle
+  * @param state The state
+  * @param move The move (0 - move_count - 1)
+  * @return The state after the move
+  */
+int puzzle_move(const Puzzle* puzzle, int state, int move){
+  const PuzzleMove* this_move = &puzzle->moves[move];
+  int i;
+  for(i = 0; i < this_move->times; i++){
+    if(puzzle->pieces == PUZZLE_ALL_PIECES){
+      state = rotate_rank(state, this_move->rotation);
+    }else{
+      state = rotate_pieces(puzzle, state, this_move->rotation);
+    }
+  }
+  return state;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Puzzle Table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates the data of an empty table for a puzzle: its name,
+  * and room for the code of every state.
+  * @param puzzle The puzzle
+  * @return A pointer to the table data
+  * @return NULL Out of memory
+  */
+uint64_t* make_puzzle_table(const Puzzle* puzzle){
+  uint64_t* data = (uint64_t*) calloc(1,
+                     puzzle_table_size(puzzle_states(puzzle)));
+  if(data != NULL){
+    strncpy((char*) data, puzzle->name, PUZZLE_NAME_WORDS * 8 - 1);
+  }
+  return data;
+}
+
+/** This function returns the size of the data of a puzzle table
+  * @param states The number of states of the puzzle
+  * @return The number of bytes of data
+  */
+size_t puzzle_table_size(int states){
+  size_t words = ((size_t) states + PUZZLE_ENTRIES_PER_WORD - 1) /
+                 PUZZLE_ENTRIES_PER_WORD;
+  return (PUZZLE_NAME_WORDS + words) * sizeof(uint64_t);
+}
+
+/** This function fills the table of a puzzle with a breadth first search
+  * from its solved state (see generate_puzzle_table_parallel)
+  * @param puzzle The puzzle
+  * @param data The table data (see make_puzzle_table)
+  * @param threads The number of threads to use
+  * @return 1 The table was filled
+  * @return 0 Out of memory
+  */
+int generate_puzzle_table(const Puzzle* puzzle, uint64_t* data, int threads){
+  return generate_puzzle_table_parallel(puzzle, data + PUZZLE_NAME_WORDS,
+                                        threads) > 0;
+}
+
+/** This function writes the table of a puzzle, with a table header, to the
+  * binary file <name>_table.bin (see table_file.c)
+  * @param puzzle The puzzle
+  * @param data The table data
+  * @return 1 The table was saved
+  * @return 0 An error occured
+  */
+int write_puzzle_table(const Puzzle* puzzle, const uint64_t* data){
+  char file_name[64];
+  int states = puzzle_states(puzzle);
+  if(!table_file_name(puzzle, file_name, sizeof(file_name)) ||
+     !save_table_states(file_name, TABLE_PUZZLE, states, data,
+                        puzzle_table_size(states))){
+    printf("An error occured while writing the %s table.\n", puzzle->name);
+    return 0;
+  }
+  return 1;
+}
+
+/** This function loads the table of a puzzle from <name>_table.bin. If that
+  * file does not exist (or holds another puzzle), the table is generated
+  * and saved so that later runs can map it directly.
+  * @param puzzle The puzzle
+  * @param threads The number of threads to generate the table with
+  * @return Pointer to the loaded table
+  * @return NULL The table could not be generated
+  */
+PuzzleTable* load_puzzle_table(const Puzzle* puzzle, int threads){
+  PuzzleTable* table = (PuzzleTable*) calloc(1, sizeof(PuzzleTable));
+  if(table == NULL) return NULL;
+  table->puzzle = puzzle;
+
+  char file_name[64];
+  size_t size = puzzle_table_size(puzzle_states(puzzle));
+  StateTable* file = NULL;
+  if(table_file_name(puzzle, file_name, sizeof(file_name))){
+    file = open_state_table(file_name, 0);
+  }
+  if(file != NULL && file->encoding == TABLE_PUZZLE &&
+     file->data_size == size &&
+     strncmp((const char*) file->data, puzzle->name,
+             PUZZLE_NAME_WORDS * 8) == 0){
+    table->file = file;
+    table->entries = (const uint64_t*) file->data + PUZZLE_NAME_WORDS;
+    return table;
+  }
+  close_state_table(file);
+
+  table->generated = make_puzzle_table(puzzle);
+  if(table->generated == NULL ||
+     !generate_puzzle_table(puzzle, table->generated, threads)){
+    close_puzzle_table(table);
+    return NULL;
+  }
+  write_puzzle_table(puzzle, table->generated);
+  table->entries = table->generated + PUZZLE_NAME_WORDS;
+  return table;
+}
+
+/** This function closes the table of a puzzle, and frees it
+  * @param table The table (or NULL)
+  */
+void close_puzzle_table(PuzzleTable* table){
+  if(table == NULL) return;
+  close_state_table(table->file);
+  free(table->generated);
+  free(table);
+}
+
+/** This function reads the code stored for a state in a puzzle table
+  * @param entries The codes of the table
+  * @param state The state
+  * @return The code: the move index + 1, 0 when solved, or PUZZLE_UNVISITED
+  */
+char puzzle_code_at(const uint64_t* entries, int state){
+  uint64_t word = entries[state / PUZZLE_ENTRIES_PER_WORD];
+  return (char) ((word >> ((state % PUZZLE_ENTRIES_PER_WORD) * 4)) & 0x0F);
+}
+
+/** This funciton solves a cube in a puzzle, into a buffer owned by the
+  * caller.
+  * @param table The table of the puzzle
+  * @param cube The cube to be solved
+  * @param moves PUZZLE_SOLUTION_SIZE chars, filled with the moves needed to
+  *    solve the cube (the move index + 1) followed by the terminator (0)
+  * @return The number of moves
+  * @return -1 signal an error (invalid cube, or the moves cannot solve it)
+  */
+int solve_puzzle_cube_into(const PuzzleTable* table, int cube, char* moves){
+  const Puzzle* puzzle = table->puzzle;
+  int state = puzzle_state(puzzle, cube);
+  if(state == -1) return -1;
+
+  char code;
+  int count = 0;
+  do{
+    code = puzzle_code_at(table->entries, state);
+    if(code > puzzle->move_count ||
+       (count == PUZZLE_SOLUTION_SIZE - 1 && code != 0)){
+      return -1; //not reachable (or a corrupt table)
+    }
+    moves[count] = code;
+    if(code != 0) state = puzzle_move(puzzle, state, code - 1);
+    count++;
+  }while(code != 0); //zero signal's final move
+  return count - 1;
+}
+
+/** This function writes a solution of a puzzle as a line of text, ending
+  * with '\n' (INVALID for a cube it could not solve). The text is not
+  * terminated.
+  * @param out PUZZLE_LINE_SIZE chars to write the line to
+  * @param puzzle The puzzle
+  * @param moves The moves, as returned by solve_puzzle_cube_into (-1 when
+  *    invalid)
+  * @return Pointer to the end of the line that was written
+  */
+char* format_puzzle_solution(char* out, const Puzzle* puzzle,
+                             const char* moves){
+  if(moves[0] == -1){
+    memcpy(out, "INVALID\n", 8);
+    return out + 8;
+  }
+  int i;
+  for(i = 0; moves[i] != 0; i++){
+    if(i > 0) *out++ = ' ';
+    const char* name = puzzle->moves[moves[i] - 1].name;
+    while(*name != '\0') *out++ = *name++;
+  }
+  *out++ = '\n';
+  return out;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function performs a rotation on the pieces of a state, for a puzzle
+  * that does not solve every piece
+  * @param puzzle The puzzle
+  * @param state The state
+  * @param rotation The rotation (0 - 5)
+  * @return The state after the rotation
+  */
+int rotate_pieces(const Puzzle* puzzle, int state, int rotation){
+  int turned = 0;
+  int place = 1;
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    if(!(puzzle->pieces & (1 << piece))) continue;
+    turned += rotate_piece(state % 21, rotation) * place;
+    state /= 21;
+    place *= 21;
+  }
+  return turned;
+}
+
+/** This function writes the name of the table file of a puzzle
+  * @param puzzle The puzzle
+  * @param file_name Filled with the file name
+  * @param size The size of file_name
+  * @return 1 The name fits
+  * @return 0 The name is too long
+  */
+int table_file_name(const Puzzle* puzzle, char* file_name, size_t size){
+  return snprintf(file_name, size, "%s_table.bin", puzzle->name) <
+         (int) size;
+}
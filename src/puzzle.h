@@ -0,0 +1,76 @@
+/** File: puzzle.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the puzzle structures and the function prototypes for
+  * the file puzzle.c
+  */
+
+#ifndef PUZZLE_H
+#define PUZZLE_H
+
+#include <stdint.h>
+#include "table_file.h"
+
+#define PUZZLE_MAX_MOVES 9 //moves of a move set (codes 1 - 9, 0 is solved)
+#define PUZZLE_SOLUTION_SIZE 24 //longest solution of any puzzle, and 0
+#define PUZZLE_LINE_SIZE 96 //longest line format_puzzle_solution writes
+#define PUZZLE_NAME_WORDS 2 //words of the name (16 chars) in table data
+#define PUZZLE_ALL_PIECES 0x7F //every moveable piece (0 - 6) is solved
+#define PUZZLE_ENTRIES_PER_WORD 16 //4 bit moves packed into a 64 bit word
+#define PUZZLE_UNVISITED 0x0F //move code of a state that was not reached
+
+/** A move of a move set: a quarter turn (a rotation, see rotate in cube.c)
+  * made once or twice.
+  */
+typedef struct PuzzleMove {
+  const char* name;     //EX: "F2"
+  char rotation;        //the rotation (0 - 5: F' F L' L U' U)
+  char times;           //1 for a quarter turn, 2 for a half turn
+  char inverse;         //the move (index in the move set) that undoes it
+} PuzzleMove;
+
+/** A variant of the cube: the moves that may be made, and the pieces that
+  * must end up solved. When every piece must be solved, a state is the rank
+  * of the cube (see rank_cube). Otherwise it is the state (position and
+  * orientation) of each solved piece, as a number in base 21.
+  */
+typedef struct Puzzle {
+  const char* name;                     //EX: "htm", names the table file
+  const char* description;
+  int pieces;                           //bit mask of the pieces to solve
+  int move_count;
+  PuzzleMove moves[PUZZLE_MAX_MOVES];
+} Puzzle;
+
+/** A loaded puzzle table. The table data is the name of the puzzle (NUL
+  * padded), followed by the move code (the move index + 1) that brings each
+  * state one move closer to solved: 0 for solved, PUZZLE_UNVISITED for a
+  * state the moves cannot reach. 16 codes are packed into every word.
+  */
+typedef struct PuzzleTable {
+  const Puzzle* puzzle;
+  const uint64_t* entries;      //the codes, indexed by state
+  uint64_t* generated;          //the table data when it was generated (NULL
+                                //when it is mapped from the file)
+  StateTable* file;             //the mapped table file, or NULL
+} PuzzleTable;
+
+//Function Prototypes
+const Puzzle* find_puzzle(const char* name);
+const Puzzle* puzzle_at(int index);
+int puzzle_states(const Puzzle* puzzle);
+int puzzle_state(const Puzzle* puzzle, int cube);
+int puzzle_move(const Puzzle* puzzle, int state, int move);
+
+uint64_t* make_puzzle_table(const Puzzle* puzzle);
+size_t puzzle_table_size(int states);
+int generate_puzzle_table(const Puzzle* puzzle, uint64_t* data, int threads);
+int write_puzzle_table(const Puzzle* puzzle, const uint64_t* data);
+PuzzleTable* load_puzzle_table(const Puzzle* puzzle, int threads);
+void close_puzzle_table(PuzzleTable* table);
+char puzzle_code_at(const uint64_t* entries, int state);
+int solve_puzzle_cube_into(const PuzzleTable* table, int cube, char* moves);
+char* format_puzzle_solution(char* out, const Puzzle* puzzle,
+                             const char* moves);
+
+#endif
@@ -5,107 +5,400 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "queue.h"
 
-/** Create a queue by allocating a Queue structure, initializing it,
- *  and allocating memory to hold the Queue entries.
- *  @param max_cells Maximum entries in the queue
- *  @return Pointer to newly-allocated Queue structure, NULL if error.
- */
-Queue* createQueue(int max_cells) {
-  Queue *new_queue; // Holds pointer to the newly-allocated queue structure.
-  new_queue = (Queue*) malloc(sizeof(Queue)); 
+//Helper Function Prototypes
+QueueStatus reserve_segments(Queue64 *queue, size_t segments);
+void next_tail_segment(Queue64 *queue);
+void next_head_segment(Queue64 *queue);
 
+/** Create a Queue64 by allocating a Queue64 structure, initializing it,
+ *  and allocating the first segment of entries. More segments are added as
+ *  the queue grows.
+ *  @param max_cells Maximum entries in the queue, 0 for no limit
+ *  @return Pointer to newly-allocated Queue64 structure, NULL if error.
+ */
+Queue64* createQueue64(size_t max_cells) {
+  Queue64 *new_queue = (Queue64*) malloc(sizeof(Queue64));
   if (new_queue == NULL) return NULL; // Error--unable to allocate.
 
-  // Fill in the struct
-  new_queue->max_cells = max_cells;
-  new_queue->cells_used= 0; //empty to begin
-
-  // Now allocate space for the queue entries.
-  new_queue->base = (int*) calloc(sizeof(int), max_cells);
-  if (new_queue->base == NULL) {
+  new_queue->head_segment = (struct queue64_segment*) 
+                            malloc(sizeof(struct queue64_segment));
+  if (new_queue->head_segment == NULL) {
     free(new_queue); // Unable to allocate queue entries, so free struct.
     return NULL;
   }
-  new_queue->head = new_queue->base; // Start at base
-  new_queue->tail = new_queue->base; // Start at base
-
+  new_queue->head_segment->next = NULL;
+  new_queue->tail_segment = new_queue->head_segment;
+  new_queue->spare = NULL;
+  new_queue->head = 0; // Start at the first cell
+  new_queue->tail = 0;
+  new_queue->max_cells = max_cells;
+  new_queue->cells_used = 0; //empty to begin
   return new_queue;
 }
 
-/** Deletes a queue, including the structure and the memory
- *  for holding the Queue, but not the entries themselves.
- *  @param queue Pointer to Queue structure.
+/** Deletes a Queue64, including the memory for its entries.
+ *  @param queue Pointer to Queue64 structure.
+ */
+void deleteQueue64(Queue64 *queue) {
+  clearQueue64(queue); //every segment but the head is now spare
+  while (queue->spare != NULL) {
+    struct queue64_segment* next = queue->spare->next;
+    free(queue->spare);
+    queue->spare = next;
+  }
+  free(queue->head_segment);
+  free(queue);
+}
+
+/** Removes every entry from a Queue64. Its segments are kept, so refilling
+ *  the queue to the same size does not allocate.
+ *  @param queue Pointer to Queue64 structure.
+ */
+void clearQueue64(Queue64 *queue) {
+  while (queue->head_segment != queue->tail_segment) {
+    next_head_segment(queue);
+  }
+  queue->head = 0;
+  queue->tail = 0;
+  queue->cells_used = 0;
+}
+
+/** enqueues a 64 bit entry onto a Queue64.
+ *  @param queue Pointer to queue you want to enqueue onto.
+ *  @param element Entry to be enqueued.
+ *  @return QUEUE_OK if successful, QUEUE_FULL if the queue holds max_cells
+ *     entries, QUEUE_NO_MEMORY if it could not grow.
+ */
+QueueStatus enqueue64(Queue64 *queue, uint64_t element) {
+  if (queue->max_cells != 0 && queue->cells_used >= queue->max_cells) {
+    return QUEUE_FULL; // queue overflow.
+  }
+  if (queue->tail == QUEUE64_SEGMENT) { // the tail segment is full
+    if (reserve_segments(queue, 1) != QUEUE_OK) return QUEUE_NO_MEMORY;
+    next_tail_segment(queue);
+  }
+  queue->tail_segment->cells[queue->tail++] = element;
+  (queue->cells_used)++;
+  return QUEUE_OK; // Success
+}
+
+/** Dequeues head of a Queue64. Every 64 bit value can be an entry, so the
+ *  entry is returned through a pointer.
+ *  @param queue Pointer to Queue64 you want to dequeue from.
+ *  @param element Filled with the head of the queue.
+ *  @return QUEUE_OK if successful, QUEUE_EMPTY if the queue is empty.
  */
-void deleteQueue(Queue *queue) {
-  free(queue->base); // Free memory block with stack entries.
-  free(queue); // Then free the struct.
+QueueStatus dequeue64(Queue64 *queue, uint64_t* element) {
+  if (queue->cells_used == 0) return QUEUE_EMPTY; // queue empty
+
+  if (queue->head == QUEUE64_SEGMENT) next_head_segment(queue);
+  *element = queue->head_segment->cells[queue->head++];
+  if (--(queue->cells_used) == 0) { //start over at the first cell
+    clearQueue64(queue);
+  }
+  return QUEUE_OK; // Success
 }
 
-/** enqueues an integer onto a queue.
+/** enqueues n entries onto a Queue64, in order. Either every entry is
+ *  enqueued or none are.
  *  @param queue Pointer to queue you want to enqueue onto.
- *  @param element Number to be enqueued.
- *  @return 0 if successful, -1 if not.
+ *  @param elements The entries to be enqueued.
+ *  @param n The number of entries.
+ *  @return QUEUE_OK if successful, QUEUE_FULL if there is no room for the
+ *     entries under max_cells, QUEUE_NO_MEMORY if the queue could not grow.
+ */
+QueueStatus enqueue64_n(Queue64 *queue, const uint64_t* elements, size_t n) {
+  if (queue->max_cells != 0 && n > queue->max_cells - queue->cells_used) {
+    return QUEUE_FULL; // queue overflow.
+  }
+  size_t room = QUEUE64_SEGMENT - queue->tail;
+  if (n > room) { // get every segment needed before changing the queue
+    size_t segments = ((n - room) + QUEUE64_SEGMENT - 1) / QUEUE64_SEGMENT;
+    if (reserve_segments(queue, segments) != QUEUE_OK) return QUEUE_NO_MEMORY;
+  }
+
+  queue->cells_used += n;
+  while (n > 0) {
+    if (queue->tail == QUEUE64_SEGMENT) next_tail_segment(queue);
+    size_t count = QUEUE64_SEGMENT - queue->tail;
+    if (count > n) count = n;
+    memcpy(&queue->tail_segment->cells[queue->tail], elements,
+           count * sizeof(uint64_t));
+    queue->tail += count;
+    elements += count;
+    n -= count;
+  }
+  return QUEUE_OK; // Success
+}
+
+/** Dequeues up to n entries from the head of a Queue64, in order.
+ *  @param queue Pointer to Queue64 you want to dequeue from.
+ *  @param elements Filled with the entries.
+ *  @param n The most entries to dequeue.
+ *  @return The number of entries dequeued (0 if the queue is empty).
  */
-int enqueue(Queue *queue, int element) {
-  // Check if queue is already full 
-  if ((queue->cells_used) >= (queue->max_cells)) {
-    queue->cells_used = queue->max_cells; // Fix
-    return -1;  // queue overflow.
+size_t dequeue64_n(Queue64 *queue, uint64_t* elements, size_t n) {
+  if (n > queue->cells_used) n = queue->cells_used;
+  size_t dequeued = n;
+  while (n > 0) {
+    if (queue->head == QUEUE64_SEGMENT) next_head_segment(queue);
+    size_t count = QUEUE64_SEGMENT - queue->head;
+    if (count > n) count = n;
+    memcpy(elements, &queue->head_segment->cells[queue->head],
+           count * sizeof(uint64_t));
+    queue->head += count;
+    elements += count;
+    n -= count;
+  }
+  queue->cells_used -= dequeued;
+  if (dequeued > 0 && queue->cells_used == 0) { //start over at the first cell
+    clearQueue64(queue);
+  }
+  return dequeued;
+}
+
+/** Create a lock-free single-producer single-consumer queue. The producer
+ *  only writes the tail and the consumer only writes the head, so neither
+ *  needs more than a load and a store, and each keeps the last index it
+ *  read from the other to touch the other's cache line as rarely as it can.
+ *  @param max_cells Maximum entries in the queue (rounded up to a power of 2)
+ *  @return Pointer to newly-allocated SPSCQueue64 structure, NULL if error.
+ */
+SPSCQueue64* createSPSCQueue64(size_t max_cells) {
+  size_t cells = 2;
+  while (cells < max_cells) cells <<= 1;
+
+  SPSCQueue64 *new_queue = (SPSCQueue64*) aligned_alloc(64, 
+                                                        sizeof(SPSCQueue64));
+  if (new_queue == NULL) return NULL; // Error--unable to allocate.
+
+  new_queue->cells = (uint64_t*) malloc(cells * sizeof(uint64_t));
+  if (new_queue->cells == NULL) {
+    free(new_queue);
+    return NULL;
   }
+  new_queue->mask = cells - 1;
+  atomic_init(&new_queue->head, 0);
+  atomic_init(&new_queue->tail, 0);
+  new_queue->tail_seen = 0;
+  new_queue->head_seen = 0;
+  return new_queue;
+}
+
+/** Deletes a SPSCQueue64, including the memory for its entries.
+ *  @param queue Pointer to SPSCQueue64 structure.
+ */
+void deleteSPSCQueue64(SPSCQueue64 *queue) {
+  free(queue->cells);
+  free(queue);
+}
 
-  // enqueue onto queue.
-  *(queue->tail) = element;  // Store the number on the queue
-  (queue->tail)++; //increment pointer
-  if (queue->tail == (queue->base + queue->max_cells)){
-    //determines if the head needs to loop back to the beginning
-    queue->tail = queue->base; //wraps it back around.
+/** enqueues a 64 bit entry onto a SPSCQueue64. Only the producer thread may
+ *  call it.
+ *  @param queue Pointer to queue you want to enqueue onto.
+ *  @param element Entry to be enqueued.
+ *  @return QUEUE_OK if successful, QUEUE_FULL if the queue is full.
+ */
+QueueStatus spsc_enqueue64(SPSCQueue64 *queue, uint64_t element) {
+  return (spsc_enqueue64_n(queue, &element, 1) == 1) ? QUEUE_OK : QUEUE_FULL;
+}
+
+/** Dequeues head of a SPSCQueue64. Only the consumer thread may call it.
+ *  @param queue Pointer to SPSCQueue64 you want to dequeue from.
+ *  @param element Filled with the head of the queue.
+ *  @return QUEUE_OK if successful, QUEUE_EMPTY if the queue is empty.
+ */
+QueueStatus spsc_dequeue64(SPSCQueue64 *queue, uint64_t* element) {
+  return (spsc_dequeue64_n(queue, element, 1) == 1) ? QUEUE_OK : QUEUE_EMPTY;
+}
+
+/** enqueues as many of n entries onto a SPSCQueue64 as there is room for,
+ *  in order. Only the producer thread may call it.
+ *  @param queue Pointer to queue you want to enqueue onto.
+ *  @param elements The entries to be enqueued.
+ *  @param n The number of entries.
+ *  @return The number of entries enqueued (0 if the queue is full).
+ */
+size_t spsc_enqueue64_n(SPSCQueue64 *queue, const uint64_t* elements,
+                        size_t n) {
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+  size_t cells = queue->mask + 1;
+  if (n > cells - (tail - queue->head_seen)) { // look for freed cells
+    queue->head_seen = atomic_load_explicit(&queue->head,
+                                            memory_order_acquire);
+    if (n > cells - (tail - queue->head_seen)) {
+      n = cells - (tail - queue->head_seen);
+    }
   }
 
-  (queue->cells_used)++; //increment count of elements.
-  return 0;  // Success
+  size_t i;
+  for (i = 0; i < n; i++) queue->cells[(tail + i) & queue->mask] = elements[i];
+  atomic_store_explicit(&queue->tail, tail + n, memory_order_release);
+  return n;
 }
 
-/** Dequeues head of queue, and returns it.
- *  @param queue Pointer to Queue you want to dequeue from.
- *  @return head of the queue, -1 if queue is empty.
+/** Dequeues up to n entries from the head of a SPSCQueue64, in order. Only
+ *  the consumer thread may call it.
+ *  @param queue Pointer to SPSCQueue64 you want to dequeue from.
+ *  @param elements Filled with the entries.
+ *  @param n The most entries to dequeue.
+ *  @return The number of entries dequeued (0 if the queue is empty).
  */
-int dequeue(Queue *queue) {
-  // Check if queue is empty
-  if ((queue->cells_used) <= 0) {
-    queue->cells_used = 0; // Fix
-    return -1;  // queue empty
+size_t spsc_dequeue64_n(SPSCQueue64 *queue, uint64_t* elements, size_t n) {
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  if (n > queue->tail_seen - head) { // look for new entries
+    queue->tail_seen = atomic_load_explicit(&queue->tail,
+                                            memory_order_acquire);
+    if (n > queue->tail_seen - head) n = queue->tail_seen - head;
   }
 
-  // dequeue from queue
-  int* head = queue->head; // Point to head
-  (queue->head)++; //increment pointer
-  if (queue->head == (queue->base + queue->max_cells)){
-    //determines if the tail needs to loop back to the beginning
-    queue->head = queue->base; //wraps it back around.
+  size_t i;
+  for (i = 0; i < n; i++) elements[i] = queue->cells[(head + i) & queue->mask];
+  atomic_store_explicit(&queue->head, head + n, memory_order_release);
+  return n;
+}
+
+/** Create a lock-free multi-producer multi-consumer queue. 
+ *  Each cell holds a sequence number that tells producers and consumers 
+ *  whether the cell is free or full for their lap around the queue, so a 
+ *  thread only needs a single compare-and-swap to claim a cell.
+ *  (based on Dmitry Vyukov's bounded MPMC queue)
+ *  @param max_cells Maximum entries in the queue (rounded up to a power of 2)
+ *  @return Pointer to newly-allocated MPMCQueue structure, NULL if error.
+ */
+MPMCQueue* createMPMCQueue(size_t max_cells) {
+  size_t cells = 2;
+  while (cells < max_cells) cells <<= 1;
+
+  MPMCQueue *new_queue = (MPMCQueue*) aligned_alloc(64, sizeof(MPMCQueue));
+  if (new_queue == NULL) return NULL; // Error--unable to allocate.
+
+  new_queue->cells = (struct mpmc_cell*) malloc(cells * 
+                                                sizeof(struct mpmc_cell));
+  if (new_queue->cells == NULL) {
+    free(new_queue);
+    return NULL;
+  }
+  size_t i;
+  for (i = 0; i < cells; i++) {
+    atomic_init(&new_queue->cells[i].sequence, i); //free for the first lap
   }
+  new_queue->mask = cells - 1;
+  atomic_init(&new_queue->enqueue_pos, 0);
+  atomic_init(&new_queue->dequeue_pos, 0);
+  return new_queue;
+}
 
-  (queue->cells_used)--;//decrement count of entries
-  return (*head); // Get the entry
-  
+/** Deletes a MPMCQueue, but not the entries themselves.
+ *  @param queue Pointer to MPMCQueue structure.
+ */
+void deleteMPMCQueue(MPMCQueue *queue) {
+  free(queue->cells);
+  free(queue);
 }
 
-/** Peek at the top of the queue, without dequeue 
- *  @param queue Pointer to the Queue you want to peek into
- *  @return Head of the Queue, -1 if queue is empty.
+/** enqueues a pointer onto a MPMCQueue. Safe to call from any thread.
+ *  @param queue Pointer to queue you want to enqueue onto.
+ *  @param element Pointer to be enqueued.
+ *  @return QUEUE_OK if successful, QUEUE_FULL if the queue is full.
  */
-int peek(Queue *queue) {
-  // Check if Queue is empty
-  if ((queue->cells_used) <= 0) {
-    queue->cells_used = 0; // Fix
-    return -1;  // Queue empty
+QueueStatus mpmc_enqueue(MPMCQueue *queue, void* element) {
+  size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+  for (;;) {
+    struct mpmc_cell* cell = &queue->cells[pos & queue->mask];
+    size_t sequence = atomic_load_explicit(&cell->sequence, 
+                                           memory_order_acquire);
+    ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) pos;
+    if (difference == 0) { // the cell is free, try to claim it
+      if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos,
+          pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+        cell->element = element;
+        atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+        return QUEUE_OK; // Success
+      }
+    } else if (difference < 0) {
+      return QUEUE_FULL; // queue overflow.
+    } else { // another producer claimed the cell first
+      pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    }
   }
+}
 
-  //Return head of queue, without dequeue
-  //Remember, 'next' points to next free cell
+/** Dequeues head of a MPMCQueue. Safe to call from any thread.
+ *  @param queue Pointer to MPMCQueue you want to dequeue from.
+ *  @param element Filled with the head of the queue.
+ *  @return QUEUE_OK if successful, QUEUE_EMPTY if the queue is empty.
+ */
+QueueStatus mpmc_dequeue(MPMCQueue *queue, void** element) {
+  size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+  for (;;) {
+    struct mpmc_cell* cell = &queue->cells[pos & queue->mask];
+    size_t sequence = atomic_load_explicit(&cell->sequence, 
+                                           memory_order_acquire);
+    ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) (pos + 1);
+    if (difference == 0) { // the cell is full, try to claim it
+      if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos,
+          pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+        *element = cell->element;
+        // free the cell for the next lap
+        atomic_store_explicit(&cell->sequence, pos + queue->mask + 1,
+                              memory_order_release);
+        return QUEUE_OK; // Success
+      }
+    } else if (difference < 0) {
+      return QUEUE_EMPTY; // queue empty
+    } else { // another consumer claimed the cell first
+      pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    }
+  }
+}
 
-  int* head = queue->head; // Point to tail
+/** Makes sure a Queue64 has spare segments, so the tail can move on to
+ *  them without allocating.
+ *  @param queue Pointer to Queue64 structure.
+ *  @param segments The number of spare segments needed.
+ *  @return QUEUE_OK if they are there, QUEUE_NO_MEMORY if not.
+ */
+QueueStatus reserve_segments(Queue64 *queue, size_t segments) {
+  struct queue64_segment* spare = queue->spare;
+  while (segments > 0 && spare != NULL) {
+    spare = spare->next;
+    segments--;
+  }
+  while (segments > 0) {
+    struct queue64_segment* segment = (struct queue64_segment*)
+                                      malloc(sizeof(struct queue64_segment));
+    if (segment == NULL) return QUEUE_NO_MEMORY;
+    segment->next = queue->spare;
+    queue->spare = segment;
+    segments--;
+  }
+  return QUEUE_OK;
+}
 
-  return (*head); // Get the entry
+/** Moves the tail of a Queue64 on to a spare segment (there must be one).
+ *  @param queue Pointer to Queue64 structure.
+ */
+void next_tail_segment(Queue64 *queue) {
+  struct queue64_segment* segment = queue->spare;
+  queue->spare = segment->next;
+  segment->next = NULL;
+  queue->tail_segment->next = segment;
+  queue->tail_segment = segment;
+  queue->tail = 0;
+}
+
+/** Moves the head of a Queue64 on to the next segment, and keeps the
+ *  emptied segment as a spare.
+ *  @param queue Pointer to Queue64 structure.
+ */
+void next_head_segment(Queue64 *queue) {
+  struct queue64_segment* segment = queue->head_segment;
+  queue->head_segment = segment->next;
+  queue->head = 0;
+  segment->next = queue->spare;
+  queue->spare = segment;
 }
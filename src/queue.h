@@ -1,29 +1,116 @@
 /** File: queue.h 
   * @author Jeff Martin
-  * This file defines a queue struct; each entry can have a pointer to anything.
-  *   The head points to the last occupied cell.
-  *   The tail points to the next free cell
-  * The file also includes all the function prototypes for queue functions.
+  * This file defines the queue structs and all the function prototypes for
+  * queue functions.
+  *
+  * The Queue64 is a first in first out queue of 64 bit entries, so an entry
+  * can carry a cube together with its depth (or any other small record). It
+  * is a chain of fixed size segments that grows as entries are added, and
+  * keeps the segments it empties for the entries that follow.
+  *
+  * The SPSCQueue64 is a bounded lock-free queue of 64 bit entries between a
+  * single producer thread and a single consumer thread.
+  *
+  * The MPMCQueue is a bounded lock-free queue of pointers that any number of
+  * threads can enqueue onto and dequeue from at the same time.
+  *
+  * Every entry value is valid, so the functions report what happened with a
+  * QueueStatus instead of a value set aside to mean "no entry".
   */
 
-struct queue{
-  int* base; //pointer to the base of the queue
-  int* head; //pointer to the last occupied cell
-  int* tail; //pointer to the next free cell. 
-  int max_cells; //Maximum number of entries in the queue
-  int cells_used; //The number of cells that are currently full.
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define QUEUE64_SEGMENT 8192 //entries in each segment of a Queue64 (64 KB)
+
+typedef enum QueueStatus{
+  QUEUE_OK = 0, //the entries were added or removed
+  QUEUE_EMPTY = -1, //there is no entry to remove
+  QUEUE_FULL = -2, //the queue holds as many entries as it is allowed
+  QUEUE_NO_MEMORY = -3 //a Queue64 could not grow
+} QueueStatus;
+
+struct queue64_segment{
+  struct queue64_segment* next; //the segment after this one
+  uint64_t cells[QUEUE64_SEGMENT]; //the entries
 };
 
-typedef struct queue Queue;
+struct queue64{
+  struct queue64_segment* head_segment; //the segment holding the head
+  struct queue64_segment* tail_segment; //the segment holding the tail
+  struct queue64_segment* spare; //emptied segments, kept for reuse
+  size_t head; //the cell of the head in head_segment
+  size_t tail; //the next free cell in tail_segment
+  size_t max_cells; //Maximum number of entries in the queue (0 no limit)
+  size_t cells_used; //The number of cells that are currently full.
+};
+
+typedef struct queue64 Queue64;
 
 //Function prototypes.
 
-Queue* createQueue(int max_cells);
+Queue64* createQueue64(size_t max_cells);
+
+void deleteQueue64(Queue64 *queue);
+
+void clearQueue64(Queue64 *queue);
+
+QueueStatus enqueue64(Queue64 *queue, uint64_t element);
+
+QueueStatus dequeue64(Queue64 *queue, uint64_t* element);
+
+QueueStatus enqueue64_n(Queue64 *queue, const uint64_t* elements, size_t n);
+
+size_t dequeue64_n(Queue64 *queue, uint64_t* elements, size_t n);
+
+struct spsc_queue64{
+  uint64_t* cells; //the entries (a power of 2 of them)
+  size_t mask; //number of cells - 1
+  _Alignas(64) atomic_size_t head; //next cell to dequeue (the consumer's)
+  size_t tail_seen; //the tail the consumer last read
+  _Alignas(64) atomic_size_t tail; //next cell to enqueue (the producer's)
+  size_t head_seen; //the head the producer last read
+};
+
+typedef struct spsc_queue64 SPSCQueue64;
+
+SPSCQueue64* createSPSCQueue64(size_t max_cells);
+
+void deleteSPSCQueue64(SPSCQueue64 *queue);
+
+QueueStatus spsc_enqueue64(SPSCQueue64 *queue, uint64_t element);
+
+QueueStatus spsc_dequeue64(SPSCQueue64 *queue, uint64_t* element);
+
+size_t spsc_enqueue64_n(SPSCQueue64 *queue, const uint64_t* elements,
+                        size_t n);
+
+size_t spsc_dequeue64_n(SPSCQueue64 *queue, uint64_t* elements, size_t n);
+
+struct mpmc_cell{
+  atomic_size_t sequence; //which lap of the queue the cell is ready for
+  void* element; //the entry
+};
+
+struct mpmc_queue{
+  struct mpmc_cell* cells; //the entries (a power of 2 of them)
+  size_t mask; //number of cells - 1
+  _Alignas(64) atomic_size_t enqueue_pos; //next cell to enqueue into
+  _Alignas(64) atomic_size_t dequeue_pos; //next cell to dequeue from
+};
+
+typedef struct mpmc_queue MPMCQueue;
+
+MPMCQueue* createMPMCQueue(size_t max_cells);
 
-void deleteQueue(Queue *queue);
+void deleteMPMCQueue(MPMCQueue *queue);
 
-int enqueue(Queue *queue, int element);
+QueueStatus mpmc_enqueue(MPMCQueue *queue, void* element);
 
-int dequeue(Queue *queue);
+QueueStatus mpmc_dequeue(MPMCQueue *queue, void** element);
 
-int peek(Queue *queue);
+#endif
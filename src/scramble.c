@@ -0,0 +1,219 @@
+/** File: scramble.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the scramble generator (see scramble.h).
+  *
+  * Applying random turns to the solved cube does not reach every cube with
+  * the same chance. Instead, a rank is drawn uniformly from 0 - 3,674,159
+  * and turned back into its cube, which is then solved with the table: the
+  * turns of the solution, undone in reverse order, are a shortest scramble
+  * that turns the solved cube into that cube. Batches are solved together
+  * (see solve_batch).
+  *
+  * To sample only the cubes at one depth, the ranks at that depth are listed
+  * from a depth table the first time the depth is asked for, and a rank is
+  * drawn uniformly from that list.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include "scramble.h"
+#include "depth_table.h"
+#include "cube.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+int list_depth(Scrambler* scrambler, int depth);
+void invert_solution(char* turns);
+uint32_t random_below(uint64_t* state, uint32_t bound);
+uint32_t xorshift_random(uint64_t* state);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Scramble Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates a scrambler. The same table and seed always give
+  * the same scrambles.
+  * @param table The loaded table (of any encoding) that solves the cubes
+  * @param seed The seed of the random numbers
+  * @return Pointer to the scrambler
+  * @return NULL Out of memory
+  */
+Scrambler* create_scrambler(const StateTable* table, uint64_t seed){
+  Scrambler* scrambler = (Scrambler*) calloc(1, sizeof(Scrambler));
+  if(scrambler == NULL) return NULL;
+  scrambler->table = table;
+
+  //mix the seed (splitmix64) so that close seeds give unrelated numbers,
+  //and the state is never 0
+  seed += 0x9E3779B97F4A7C15ULL;
+  seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+  seed ^= seed >> 31;
+  scrambler->random = (seed == 0) ? 1 : seed;
+  return scrambler;
+}
+
+/** This function frees a scrambler (but not its table)
+  * @param scrambler The scrambler
+  */
+void free_scrambler(Scrambler* scrambler){
+  if(scrambler == NULL) return;
+  int depth;
+  for(depth = 0; depth < SOLUTION_SIZE; depth++){
+    free(scrambler->depth_ranks[depth]);
+  }
+  free(scrambler->depth_table);
+  free(scrambler);
+}
+
+/** This function samples one cube and its scramble (see scramble_batch)
+  * @param scrambler The scrambler
+  * @param depth The number of turns of the scramble, or SCRAMBLE_ANY_DEPTH
+  * @param scramble SOLUTION_SIZE chars, filled with the turns of the
+  *    scramble (as returned by solve_cube)
+  * @return The integer representation of the cube
+  * @return -1 No cube is at that depth, the table could not solve the cube,
+  *    or out of memory
+  */
+int scramble_cube(Scrambler* scrambler, int depth, char* scramble){
+  int cube;
+  if(scramble_batch(scrambler, depth, &cube, scramble, 1) != 1) return -1;
+  return (scramble[0] == -1) ? -1 : cube;
+}
+
+/** This function samples a batch of cubes, each uniformly from every cube
+  * (or from every cube at one depth), with a shortest scramble that turns
+  * the solved cube into each one.
+  * @param scrambler The scrambler
+  * @param depth The number of turns of the scrambles, or SCRAMBLE_ANY_DEPTH
+  * @param cubes Filled with the n cubes
+  * @param scrambles n * SOLUTION_SIZE chars, filled with the turns of each
+  *    scramble (as returned by solve_batch). A cube the table could not
+  *    solve is given the single turn -1.
+  * @param n The number of cubes
+  * @return n The cubes were sampled
+  * @return 0 No cube is at that depth, or out of memory
+  */
+size_t scramble_batch(Scrambler* scrambler, int depth, int* cubes,
+                      char* scrambles, size_t n){
+  const int* ranks = NULL;
+  uint32_t count = NUMBER_OF_CUBES;
+  if(depth != SCRAMBLE_ANY_DEPTH){
+    if(depth < 0 || depth >= SOLUTION_SIZE || !list_depth(scrambler, depth) ||
+       scrambler->depth_counts[depth] == 0) return 0;
+    ranks = scrambler->depth_ranks[depth];
+    count = (uint32_t) scrambler->depth_counts[depth];
+  }
+
+  size_t i;
+  for(i = 0; i < n; i++){
+    uint32_t pick = random_below(&scrambler->random, count);
+    cubes[i] = unrank_cube((ranks == NULL) ? (int) pick : ranks[pick]);
+  }
+  solve_batch(cubes, n, scrambler->table, scrambles);
+  for(i = 0; i < n; i++) invert_solution(&scrambles[i * SOLUTION_SIZE]);
+  return n;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function lists the ranks at a depth, the first time it is asked
+  * for. The depths are read from the table when it is a depth table, and
+  * from a generated depth table otherwise.
+  * @param scrambler The scrambler
+  * @param depth The depth (0 - 14)
+  * @return 1 The ranks are listed
+  * @return 0 Out of memory
+  */
+int list_depth(Scrambler* scrambler, int depth){
+  if(scrambler->depth_ranks[depth] != NULL ||
+     scrambler->depth_counts[depth] != 0) return 1;
+
+  const uint8_t* depth_table = scrambler->depth_table;
+  if(scrambler->table->encoding == TABLE_DEPTH){
+    depth_table = (const uint8_t*) scrambler->table->data;
+  }else if(depth_table == NULL){
+    scrambler->depth_table = make_depth_table();
+    if(scrambler->depth_table == NULL) return 0;
+    if(!generate_depth_table(scrambler->depth_table)){
+      free(scrambler->depth_table);
+      scrambler->depth_table = NULL;
+      return 0;
+    }
+    depth_table = scrambler->depth_table;
+  }
+
+  size_t count = 0;
+  int rank;
+  for(rank = 0; rank < NUMBER_OF_CUBES; rank++){
+    if(depth_at(depth_table, rank) == depth) count++;
+  }
+  if(count == 0) return 1;
+  int* ranks = (int*) malloc(count * sizeof(int));
+  if(ranks == NULL) return 0;
+  count = 0;
+  for(rank = 0; rank < NUMBER_OF_CUBES; rank++){
+    if(depth_at(depth_table, rank) == depth) ranks[count++] = rank;
+  }
+  scrambler->depth_ranks[depth] = ranks;
+  scrambler->depth_counts[depth] = count;
+  return 1;
+}
+
+/** This function turns a solution into the scramble it undoes: the turns
+  * are reversed, and each one is replaced by its inverse (the same face
+  * turned the other way: 1 <-> 2, 3 <-> 4, 5 <-> 6).
+  * @param turns The turns, as returned by solve_cube (replaced by the
+  *    scramble, an invalid cube is left as it is)
+  */
+void invert_solution(char* turns){
+  if(turns[0] == -1) return;
+  int length = 0;
+  while(length < SOLUTION_SIZE - 1 && turns[length] != 0) length++;
+  int i;
+  for(i = 0; i < length - 1 - i; i++){
+    char turn = turns[i];
+    turns[i] = turns[length - 1 - i];
+    turns[length - 1 - i] = turn;
+  }
+  for(i = 0; i < length; i++) turns[i] = ((turns[i] - 1) ^ 1) + 1;
+}
+
+/** This function draws a random number below a bound, with no bias towards
+  * any number (Lemire's multiply and reject)
+  * @param state The state of the random numbers
+  * @param bound The bound (at least 1)
+  * @return A random number in [0, bound)
+  */
+uint32_t random_below(uint64_t* state, uint32_t bound){
+  uint64_t product = (uint64_t) xorshift_random(state) * bound;
+  uint32_t low = (uint32_t) product;
+  if(low < bound){
+    uint32_t threshold = -bound % bound; //2^32 mod bound
+    while(low < threshold){
+      product = (uint64_t) xorshift_random(state) * bound;
+      low = (uint32_t) product;
+    }
+  }
+  return (uint32_t) (product >> 32);
+}
+
+/** This function returns the next random number (xorshift64*)
+  * @param state The state of the random numbers (never 0)
+  * @return The next random number
+  */
+uint32_t xorshift_random(uint64_t* state){
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return (uint32_t) ((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
@@ -0,0 +1,40 @@
+/** File: scramble.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the scrambler structure and the function prototypes
+  * for the file scramble.c
+  */
+
+#ifndef SCRAMBLE_H
+#define SCRAMBLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "table_file.h"
+#include "state_table.h"
+
+#define SCRAMBLE_ANY_DEPTH -1 //sample from every cube, whatever its depth
+
+/** Samples uniformly random cubes and the shortest scramble that reaches
+  * each one from the solved cube. A scrambler must only be used by one
+  * thread at a time.
+  */
+typedef struct Scrambler {
+  const StateTable* table;              //solves the sampled cubes
+  uint64_t random;                      //state of the random numbers
+  uint8_t* depth_table;                 //made when a depth is first asked
+                                        //for (NULL until then, or when the
+                                        //table is itself a depth table)
+  int* depth_ranks[SOLUTION_SIZE];      //the ranks at each depth (made when
+                                        //the depth is first asked for)
+  size_t depth_counts[SOLUTION_SIZE];   //the number of ranks at each depth
+} Scrambler;
+
+//Function Prototypes
+Scrambler* create_scrambler(const StateTable* table, uint64_t seed);
+void free_scrambler(Scrambler* scrambler);
+int scramble_cube(Scrambler* scrambler, int depth, char* scramble);
+size_t scramble_batch(Scrambler* scrambler, int depth, int* cubes,
+                      char* scrambles, size_t n);
+
+#endif
@@ -0,0 +1,480 @@
+/** File: search.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the solvers that need no state table, so that cubes
+  * can be solved before a table has been loaded or generated.
+  *
+  * The bidirectional search meets in the middle. The cubes within 7 moves
+  * of solved (44,971 of them) are found once with a breadth first search and
+  * kept in a hash set shared by every search. A cube is then solved with a
+  * breadth first search from the cube, on rank coordinates, until it reaches
+  * a cube in that set: every cube is at most 14 moves from solved, so this
+  * search also stops within 7 moves. A cube first reached at depth d that is
+  * in the set is at most 7 moves from solved, and no cube reached earlier
+  * was, so the shortest solution has d + 7 moves (or the cube itself is in
+  * the set) and the first cube found lies on a shortest solution. The set
+  * takes 256 KB and is built once, for every thread. Each thread that
+  * searches also keeps 256 KB in an arena (see arena.c) for the cubes its
+  * search has reached, and a queue of up to 42,028 cubes (336 KB). They are
+  * reused by every search of the thread, so a search does not allocate once
+  * they have grown, and are freed when the thread exits.
+  *
+  * The IDA* search (iterative deepening A*) needs even less memory: a depth
+  * first search that is cut off once the moves made plus a lower bound on
+  * the moves left pass the current limit, and the limit is raised by one
+  * until a solution is found, so the first solution is a shortest one. The
+  * lower bound is the larger of the distance of the permutation alone and
+  * of the orientation alone from solved, looked up in two small tables
+  * (5040 and 729 bytes). A turn is never followed by its inverse, and the
+  * same turn is never made three times in a row (that is the inverse).
+  * Together with the move tables about 75 KB is used, instead of a 1.4 MB
+  * table.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "search.h"
+#include "table_file.h"
+#include "state_table.h"
+#include "queue.h"
+#include "cube.h"
+#include "arena.h"
+
+#define HALF_DEPTH 7 //each half of a solution has at most 7 turns
+#define HALF_BITS 16 //slots in each hash set (2^16), at most 69% full
+#define HALF_SLOTS (1 << HALF_BITS)
+#define FRONTIER_CELLS 42028 //two levels in a row (8,969 + 33,058) and 1
+#define RANK_MASK 0x3FFFFF //the rank is stored in the low 22 bits of a slot
+#define ROOT 0x07 //rotation code of the cube a search started from
+#define SEARCH_SCRATCH (HALF_SLOTS * sizeof(RankSet)) //arena of a search
+
+/** A hash set of the cubes a breadth first search has reached. A slot holds
+  * bits 0 - 21 the rank of the cube and bits 22 - 24 the rotation that
+  * reached it plus 1 (ROOT for the first cube). An empty slot is 0.
+  */
+typedef uint32_t RankSet;
+
+//the cubes within HALF_DEPTH moves of solved, built by solved_half_set
+static RankSet* solved_half = NULL;
+
+//the memory of the searches made by a thread, reset before each search
+typedef struct SearchScratch {
+  Arena* arena;         //the cubes a search has reached
+  Queue64* frontier;    //the cubes a search has yet to turn
+} SearchScratch;
+
+//the scratch of this thread (the key frees it when the thread exits)
+static _Thread_local SearchScratch* search_scratch = NULL;
+static pthread_key_t scratch_key;
+static pthread_once_t scratch_key_once = PTHREAD_ONCE_INIT;
+
+//distance from solved of each permutation and of each orientation, filled by
+//fill_distance_tables
+static uint8_t perm_distance[NUMBER_OF_PERMUTATIONS];
+static uint8_t orient_distance[NUMBER_OF_ORIENTATIONS];
+static pthread_once_t distance_tables_once = PTHREAD_ONCE_INIT;
+static int solved_perm, solved_orient;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+const RankSet* solved_half_set();
+SearchScratch* thread_scratch();
+void create_scratch_key();
+void free_scratch(void* scratch);
+void fill_distance_tables();
+uint32_t find_rank(const RankSet* set, int rank);
+int add_rank(RankSet* set, int rank, int rotation);
+int path_to_root(const RankSet* set, int rank, char* rotations);
+void fill_distances(uint8_t* distance, int size,
+                    const unsigned short (*move_table)[6], int solved);
+int ida_search(int perm, int orient, int depth, int limit, int last,
+               int repeats, char* turn_sequence);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Search Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function solves a cube with the bidirectional search, which needs
+  * no table. The solution is as short as possible.
+  * @param cube The cube to be solved
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube, or out of memory)
+  */
+int search_solve_cube_into(int cube, char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+  const RankSet* half = solved_half_set();
+  if(half == NULL) return -1;
+
+  RankSet* reached = NULL;
+  char rotations[SOLUTION_SIZE * 2];
+  int to_cube = 0;
+  int meet = (find_rank(half, rank) != 0) ? rank : -1;
+  if(meet == -1){
+    SearchScratch* scratch = thread_scratch();
+    if(scratch == NULL) return -1;
+    arena_reset(scratch->arena);
+    reached = (RankSet*) arena_calloc(scratch->arena, HALF_SLOTS,
+                                      sizeof(RankSet));
+    if(reached == NULL) return -1;
+    Queue64* frontier = scratch->frontier;
+    clearQueue64(frontier);
+    add_rank(reached, rank, ROOT - 1);
+    //entry: depth << 32 | rank
+    if(enqueue64(frontier, (uint64_t) rank) != QUEUE_OK) return -1;
+
+    uint64_t entry;
+    while(meet == -1 && dequeue64(frontier, &entry) == QUEUE_OK){
+      int depth = (int) (entry >> 32);
+      int this_rank = (int) (entry & RANK_MASK);
+      int rotation;
+      for(rotation = 0; rotation < 6 && meet == -1; rotation++){
+        int next = rotate_rank(this_rank, rotation);
+        if(add_rank(reached, next, rotation) != 1) continue;
+        if(find_rank(half, next) != 0) meet = next;
+        else if(depth + 1 < HALF_DEPTH &&
+                enqueue64(frontier, (((uint64_t) (depth + 1)) << 32) | next)
+                != QUEUE_OK){
+          return -1; //the cube would be lost, so the search is not sound
+        }
+      }
+    }
+    if(meet != -1) to_cube = path_to_root(reached, meet, rotations);
+  }
+
+  int count = -1;
+  if(meet != -1){
+    //rotations from the cube to the meeting cube, then on to solved
+    int to_solved = path_to_root(half, meet, &rotations[to_cube]);
+    if(to_cube + to_solved < SOLUTION_SIZE){
+      int i;
+      for(i = 0; i < to_cube; i++){ //the path from the cube is listed backwards
+        turn_sequence[i] = rotations[to_cube - 1 - i] + 1;
+      }
+      for(i = 0; i < to_solved; i++){ //undo the turns away from solved
+        turn_sequence[to_cube + i] = (rotations[to_cube + i] ^ 1) + 1;
+      }
+      count = to_cube + to_solved;
+      turn_sequence[count] = 0;
+    }
+  }
+  return count;
+}
+
+/** This function checks the solution a table gives for a cube against the
+  * bidirectional search: the turns must solve the cube, and there must be
+  * no shorter solution.
+  * @param table The loaded table
+  * @param cube The cube to check
+  * @return 1 The table gives a shortest solution
+  * @return 0 The table entry is wrong
+  * @return -1 The cube is invalid
+  */
+int verify_table_cube(const StateTable* table, int cube){
+  char turn_sequence[SOLUTION_SIZE];
+  char shortest[SOLUTION_SIZE];
+  int optimal = search_solve_cube_into(cube, shortest);
+  if(optimal == -1) return -1;
+
+  int count = table_solve_cube_into(table, cube, turn_sequence);
+  if(count != optimal) return 0;
+  int i;
+  for(i = 0; i < count; i++) cube = rotate(cube, turn_sequence[i] - 1);
+  return cube == SOLVED_CUBE;
+}
+
+/** This function fills the permutation and orientation distance tables used
+  * by the IDA* search. The tables are filled by the first call only (see
+  * fill_distance_tables), and every other thread calling in waits for them,
+  * so it is safe to call from several threads at once.
+  */
+void init_distance_tables(){
+  pthread_once(&distance_tables_once, fill_distance_tables);
+}
+
+/** This function solves a cube with the IDA* search, which needs no table.
+  * The solution is as short as possible.
+  * @param cube The cube to be solved
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int ida_solve_cube_into(int cube, char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+  init_distance_tables();
+
+  int perm = rank / NUMBER_OF_ORIENTATIONS;
+  int orient = rank % NUMBER_OF_ORIENTATIONS;
+  int limit = perm_distance[perm];
+  if(orient_distance[orient] > limit) limit = orient_distance[orient];
+  for(; limit < SOLUTION_SIZE; limit++){
+    int count = ida_search(perm, orient, 0, limit, -1, 0, turn_sequence);
+    if(count != -1){
+      turn_sequence[count] = 0;
+      return count;
+    }
+  }
+  return -1;
+}
+
+/** This function creates a table that solves by search instead of looking
+  * cubes up, so a solving engine can be picked at run time.
+  * @param encoding TABLE_SEARCH (bidirectional search, 256 KB plus about
+  *    600 KB for each thread solving) or TABLE_IDA (IDA* search, about
+  *    75 KB)
+  * @return Pointer to the table
+  * @return NULL The encoding is not a search, or out of memory
+  */
+StateTable* open_search_table(int encoding){
+  if(encoding != TABLE_SEARCH && encoding != TABLE_IDA) return NULL;
+  StateTable* table = (StateTable*) calloc(1, sizeof(StateTable));
+  if(table == NULL) return NULL;
+  if(encoding == TABLE_IDA) init_distance_tables();
+  table->encoding = encoding;
+  return table;
+}
+
+/** This function solves a cube with the search of a search table
+  * @param table The search table (see open_search_table)
+  * @param cube The cube to be solved
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int search_table_solve_into(const StateTable* table, int cube,
+                            char* turn_sequence){
+  if(table->encoding == TABLE_IDA){
+    return ida_solve_cube_into(cube, turn_sequence);
+  }
+  return search_solve_cube_into(cube, turn_sequence);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function returns the set of cubes within HALF_DEPTH moves of solved,
+  * and builds it the first time. It is safe to call from several threads at
+  * once (a thread that loses the race frees its copy).
+  * @return The set
+  * @return NULL Out of memory
+  */
+const RankSet* solved_half_set(){
+  RankSet* set = __atomic_load_n(&solved_half, __ATOMIC_ACQUIRE);
+  if(set != NULL) return set;
+
+  set = (RankSet*) calloc(HALF_SLOTS, sizeof(RankSet));
+  Queue64* frontier = createQueue64(FRONTIER_CELLS);
+  if(set == NULL || frontier == NULL){
+    free(set);
+    if(frontier != NULL) deleteQueue64(frontier);
+    return NULL;
+  }
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  add_rank(set, solved_rank, ROOT - 1);
+  int complete = (enqueue64(frontier, (uint64_t) solved_rank) == QUEUE_OK);
+  uint64_t entry;
+  while(complete && dequeue64(frontier, &entry) == QUEUE_OK){
+    int depth = (int) (entry >> 32);
+    int rotation;
+    for(rotation = 0; rotation < 6 && complete; rotation++){
+      int next = rotate_rank((int) (entry & RANK_MASK), rotation);
+      if(add_rank(set, next, rotation) == 1 && depth + 1 < HALF_DEPTH){
+        complete = (enqueue64(frontier, (((uint64_t) (depth + 1)) << 32) |
+                              next) == QUEUE_OK);
+      }
+    }
+  }
+  deleteQueue64(frontier);
+  if(!complete){ //a cube was lost, so the set would be missing cubes
+    free(set);
+    return NULL;
+  }
+
+  RankSet* expected = NULL;
+  if(!__atomic_compare_exchange_n(&solved_half, &expected, set, 0,
+                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+    free(set); //another thread built it first
+    return expected;
+  }
+  return set;
+}
+
+/** This function returns the scratch memory of the searches made by this
+  * thread, and creates it the first time. It is freed when the thread exits.
+  * @return The scratch of the thread
+  * @return NULL Out of memory
+  */
+SearchScratch* thread_scratch(){
+  if(search_scratch != NULL) return search_scratch;
+  pthread_once(&scratch_key_once, create_scratch_key);
+
+  SearchScratch* scratch = (SearchScratch*) malloc(sizeof(SearchScratch));
+  if(scratch == NULL) return NULL;
+  scratch->arena = create_arena(SEARCH_SCRATCH);
+  scratch->frontier = createQueue64(FRONTIER_CELLS);
+  if(scratch->arena == NULL || scratch->frontier == NULL ||
+     pthread_setspecific(scratch_key, scratch) != 0){
+    free_scratch(scratch);
+    return NULL;
+  }
+  search_scratch = scratch;
+  return scratch;
+}
+
+/** This function creates the key that frees the scratch of each thread when
+  * the thread exits
+  */
+void create_scratch_key(){
+  pthread_key_create(&scratch_key, free_scratch);
+}
+
+/** This function frees the scratch of a thread
+  * @param scratch The scratch (a SearchScratch)
+  */
+void free_scratch(void* scratch){
+  SearchScratch* search = (SearchScratch*) scratch;
+  if(search->arena != NULL) free_arena(search->arena);
+  if(search->frontier != NULL) deleteQueue64(search->frontier);
+  free(search);
+}
+
+/** This function fills the distance tables (see init_distance_tables)
+  */
+void fill_distance_tables(){
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  solved_perm = solved_rank / NUMBER_OF_ORIENTATIONS;
+  solved_orient = solved_rank % NUMBER_OF_ORIENTATIONS;
+  fill_distances(perm_distance, NUMBER_OF_PERMUTATIONS, perm_move_table,
+                 solved_perm);
+  fill_distances(orient_distance, NUMBER_OF_ORIENTATIONS, orient_move_table,
+                 solved_orient);
+}
+
+/** This function finds a cube in a hash set of cubes
+  * @param set The set
+  * @param rank The rank of the cube
+  * @return The slot of the cube
+  * @return 0 The cube is not in the set
+  */
+uint32_t find_rank(const RankSet* set, int rank){
+  uint32_t slot = (((uint32_t) rank) * 2654435761u) >> (32 - HALF_BITS);
+  while(set[slot] != 0){
+    if((int) (set[slot] & RANK_MASK) == rank) return set[slot];
+    slot = (slot + 1) & (HALF_SLOTS - 1);
+  }
+  return 0;
+}
+
+/** This function adds a cube to a hash set of cubes, unless it is already
+  * in the set. The set never holds more than the cubes within 7 moves of
+  * one cube, so it is never full.
+  * @param set The set
+  * @param rank The rank of the cube
+  * @param rotation The rotation that reached the cube (ROOT - 1 for the first)
+  * @return 1 The cube was added
+  * @return 0 The cube was already in the set
+  */
+int add_rank(RankSet* set, int rank, int rotation){
+  uint32_t slot = (((uint32_t) rank) * 2654435761u) >> (32 - HALF_BITS);
+  while(set[slot] != 0){
+    if((int) (set[slot] & RANK_MASK) == rank) return 0;
+    slot = (slot + 1) & (HALF_SLOTS - 1);
+  }
+  set[slot] = rank | ((uint32_t) (rotation + 1) << 22);
+  return 1;
+}
+
+/** This function lists the rotations that reached a cube, from the cube back
+  * to the cube the search started from.
+  * @param set The cubes the search reached
+  * @param rank The rank of a cube in the set
+  * @param rotations Filled with the rotations, the last one first
+  * @return The number of rotations
+  */
+int path_to_root(const RankSet* set, int rank, char* rotations){
+  int count = 0;
+  int code = find_rank(set, rank) >> 22;
+  while(code != ROOT && count < SOLUTION_SIZE){
+    rotations[count++] = code - 1;
+    rank = rotate_rank(rank, (code - 1) ^ 1); //back to the cube before
+    code = find_rank(set, rank) >> 22;
+  }
+  return count;
+}
+
+/** This function fills a distance table with a breadth first search from
+  * the solved coordinate, using one of the move tables.
+  * @param distance The table to fill (size entries)
+  * @param size The number of coordinates
+  * @param move_table perm_move_table or orient_move_table
+  * @param solved The coordinate of the solved cube
+  */
+void fill_distances(uint8_t* distance, int size,
+                    const unsigned short (*move_table)[6], int solved){
+  unsigned short queue[NUMBER_OF_PERMUTATIONS];
+  int head = 0;
+  int tail = 0;
+  memset(distance, 0xFF, size);
+  distance[solved] = 0;
+  queue[tail++] = solved;
+  while(head < tail){
+    int coordinate = queue[head++];
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      int next = move_table[coordinate][rotation];
+      if(distance[next] == 0xFF){
+        distance[next] = distance[coordinate] + 1;
+        queue[tail++] = next;
+      }
+    }
+  }
+}
+
+/** This function searches every turn sequence that can solve a cube within
+  * the limit, depth first.
+  * @param perm The permutation rank of the cube
+  * @param orient The orientation rank of the cube
+  * @param depth The number of turns made so far
+  * @param limit The most turns the solution may have
+  * @param last The last rotation made (-1 for none)
+  * @param repeats How many times the last rotation was made in a row
+  * @param turn_sequence Filled with the turns made so far
+  * @return The number of turns of the solution
+  * @return -1 No solution within the limit
+  */
+int ida_search(int perm, int orient, int depth, int limit, int last,
+               int repeats, char* turn_sequence){
+  int bound = perm_distance[perm];
+  if(orient_distance[orient] > bound) bound = orient_distance[orient];
+  if(bound == 0) return depth; //both coordinates are solved
+  if(depth + bound > limit) return -1;
+
+  int rotation;
+  for(rotation = 0; rotation < 6; rotation++){
+    if(last != -1 && rotation == (last ^ 1)) continue; //undoes the last turn
+    if(rotation == last && repeats == 2) continue; //same as the inverse
+    turn_sequence[depth] = rotation + 1;
+    int count = ida_search(perm_move_table[perm][rotation],
+                           orient_move_table[orient][rotation], depth + 1,
+                           limit, rotation,
+                           (rotation == last) ? repeats + 1 : 1,
+                           turn_sequence);
+    if(count != -1) return count;
+  }
+  return -1;
+}
@@ -0,0 +1,21 @@
+/** File: search.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file search.c
+  */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "table_file.h"
+
+//Function Prototypes
+int search_solve_cube_into(int cube, char* turn_sequence);
+int verify_table_cube(const StateTable* table, int cube);
+void init_distance_tables();
+int ida_solve_cube_into(int cube, char* turn_sequence);
+StateTable* open_search_table(int encoding);
+int search_table_solve_into(const StateTable* table, int cube,
+                            char* turn_sequence);
+
+#endif
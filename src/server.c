@@ -0,0 +1,758 @@
+/** File: server.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the multithreaded solve server.
+  *
+  * A fixed pool of worker threads shares one read-only state table and takes
+  * solve jobs from a lock-free MPMC queue (see queue.c). Jobs are whole
+  * batches of cubes. Two semaphores count the jobs in the queue and the free
+  * cells, so idle workers sleep until a job is submitted, and a thread
+  * submitting a job to a full queue sleeps until a worker takes one.
+  *
+  * The protocol is the same as the batch mode (solver -b): each line holds
+  * one cube (24 colors or the integer representation), and each cube is
+  * answered with one line holding its turns seperated by spaces. The line
+  * STATS is answered with the thread count and per worker throughput, one
+  * STATS line each, followed by STATS END. When the server has a solution
+  * cache (see solution_cache.c), a STATS cache line gives its hits and misses.
+  * The line METRICS is answered with the instrumentation of the solver (see
+  * metrics.c) followed by METRICS END. A client can also send an HTTP
+  * request for /metrics: it is answered with the same text in an HTTP
+  * response and the connection is closed, so the server can be scraped.
+  *
+  * A client connection can also follow a cube turn by turn (see
+  * session.c): the line SESSION followed by a cube starts a session on the
+  * cube, and each line TURN followed by a turn (EX: TURN F') makes the turn
+  * on it. Both are answered with the solution of the cube as it is then, or
+  * INVALID for a cube or a turn that is not valid. Each connection has one
+  * session; on stdin they are answered INVALID.
+  *
+  * When serving a socket, each client connection has a thread of its own
+  * that reads its lines and writes the answers, and submits each batch of
+  * its cubes to the workers as a job. An idle client only holds its own
+  * thread, never a worker. When serving stdin, the input is cut into chunks
+  * of whole lines that are solved in parallel and written back to stdout in
+  * order.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#define _GNU_SOURCE //memrchr
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "server.h"
+#include "state_table.h"
+#include "parse.h"
+#include "cube.h"
+#include "metrics.h"
+#include "session.h"
+#include "queue.h"
+
+#define JOB_SOLVE 1 //solve a batch of cubes for a client connection
+#define JOB_CHUNK 2 //solve a chunk of lines from stdin
+#define MAX_JOBS 1024 //jobs waiting in the queue
+#define BATCH_SIZE 1024 //cubes solved per call to solve_batch
+#define IN_SIZE 65536 //bytes read from a client at a time
+#define CHUNK_SIZE 262144 //bytes of stdin solved by one job
+
+//cubes collected from lines of text, and their solutions
+typedef struct LineBatch {
+  int cubes[BATCH_SIZE];      //cubes waiting to be solved
+  size_t pending;             //number of cubes waiting to be solved
+  char solutions[BATCH_SIZE * SOLUTION_SIZE];
+  char out[BATCH_SIZE * OUTPUT_LINE_SIZE];
+} LineBatch;
+
+typedef struct Job {
+  int type;             //JOB_SOLVE or JOB_CHUNK
+  LineBatch* batch;     //the cubes to solve (JOB_SOLVE)
+  char* text;           //whole lines to solve (JOB_CHUNK)
+  size_t text_size;
+  char* out;            //the solutions to the lines (JOB_CHUNK)
+  size_t out_size;
+  size_t out_capacity;
+  int failed;           //out of memory for the solutions (JOB_CHUNK)
+  sem_t done;           //posted once the job is done
+} Job;
+
+typedef struct WorkerStats {
+  atomic_ullong cubes;        //cubes solved
+  atomic_ullong busy_ns;      //time spent solving
+} WorkerStats;
+
+typedef struct Worker {
+  int id;
+  LineBatch batch;            //the cubes of the chunk being solved
+} Worker;
+
+//a client of the server, served by a thread of its own
+typedef struct Connection {
+  int fd;                     //the client socket
+  Job job;                    //the cubes of the client, solved by a worker
+  LineBatch batch;
+  SolveSession session;
+  char in[IN_SIZE];
+} Connection;
+
+//where solutions are written
+typedef struct Sink {
+  Connection* connection; //the client to write to, or NULL (a chunk)
+  Job* job;             //chunk to append to, or NULL
+  int worker;           //the worker solving the chunk (a chunk only)
+  int failed;           //the client has gone away, or out of memory
+} Sink;
+
+//global variables (local to file)
+static const StateTable* server_table;
+static SolutionCache* server_cache; //NULL when the server has no cache
+static MPMCQueue* job_queue; //the jobs waiting for a worker
+static sem_t queued_jobs; //jobs enqueued and not yet taken
+static sem_t free_jobs; //cells of the queue that are free
+static WorkerStats* stats;
+static int worker_count = 0;
+static atomic_ullong connections; //client connections accepted
+static struct timespec start_time;
+static volatile sig_atomic_t stopping = 0;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+int start_workers(int threads, pthread_t* thread_ids);
+void* worker_main(void* arg);
+void submit_job(Job* job);
+Job* take_job();
+void wait_semaphore(sem_t* semaphore);
+int serve_socket(int port);
+int serve_stdin(int threads);
+void* connection_main(void* arg);
+void solve_text(LineBatch* batch, Sink* sink, char* text, size_t size);
+void flush_cubes(LineBatch* batch, Sink* sink);
+void solve_cubes(LineBatch* batch, int worker_id);
+int emit(Sink* sink, const char* data, size_t size);
+void emit_metrics(Sink* sink, int http);
+void emit_session(Sink* sink, const char* text, int start);
+int is_command(const char* line, const char* command);
+size_t format_server_stats(char* out, size_t size);
+double seconds_since(const struct timespec* start);
+void on_stop_signal(int signal_number);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Server Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function runs the solve server.
+  * @param table The loaded state table, shared by every worker
+  * @param cache The solution cache shared by every worker, or NULL
+  * @param port The TCP port to listen on, or 0 to serve stdin/stdout
+  * @param threads The number of worker threads
+  * @return 0 The server shut down normally
+  * @return 1 The server could not be started
+  */
+int run_server(const StateTable* table, SolutionCache* cache, int port,
+               int threads){
+  if(threads < 1) threads = 1;
+  server_table = table;
+  server_cache = cache;
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  stats = (WorkerStats*) calloc(threads, sizeof(WorkerStats));
+  job_queue = createMPMCQueue(MAX_JOBS);
+  if(stats == NULL || job_queue == NULL || sem_init(&queued_jobs, 0, 0) != 0 ||
+     sem_init(&free_jobs, 0, MAX_JOBS) != 0){
+    printf("The server could not be started.\n");
+    return 1;
+  }
+  worker_count = threads;
+
+  if(port == 0) return serve_stdin(threads);
+  return serve_socket(port);
+}
+
+/** This function prints the thread count and the throughput of each worker
+  * @param out The stream to print to
+  */
+void print_server_stats(FILE* out){
+  size_t size = 384 + (worker_count * 128);
+  char* text = (char*) malloc(size);
+  if(text == NULL) return;
+  format_server_stats(text, size);
+  fputs(text, out);
+  free(text);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function starts the worker threads
+  * @param threads The number of worker threads
+  * @param thread_ids Filled with the id of each thread (or NULL)
+  * @return 1 The workers were started
+  * @return 0 A thread could not be created
+  */
+int start_workers(int threads, pthread_t* thread_ids){
+  int i;
+  for(i = 0; i < threads; i++){
+    pthread_t thread_id;
+    if(pthread_create(&thread_id, NULL, worker_main,
+                      (void*) (intptr_t) i) != 0) return 0;
+    if(thread_ids != NULL) thread_ids[i] = thread_id;
+    else pthread_detach(thread_id);
+  }
+  return 1;
+}
+
+/** This function is run by each worker thread. It takes jobs from the queue
+  * until it is given a NULL job.
+  * @param arg The id of the worker
+  * @return NULL
+  */
+void* worker_main(void* arg){
+  Worker* worker = (Worker*) malloc(sizeof(Worker));
+  if(worker == NULL) return NULL;
+  worker->id = (int) (intptr_t) arg;
+  worker->batch.pending = 0;
+
+  for(;;){
+    Job* job = take_job();
+    if(job == NULL) break; //shut down
+
+    if(job->type == JOB_SOLVE){
+      solve_cubes(job->batch, worker->id);
+    }else{
+      Sink sink = {NULL, job, worker->id, 0};
+      job->out_size = 0;
+      job->failed = 0;
+      solve_text(&worker->batch, &sink, job->text, job->text_size);
+      flush_cubes(&worker->batch, &sink);
+      worker->batch.pending = 0; //dropped if the chunk failed
+      job->failed = sink.failed;
+    }
+    sem_post(&job->done);
+  }
+  free(worker);
+  return NULL;
+}
+
+/** This function hands a job to the workers. When the queue is full, it
+  * waits for a worker to take a job.
+  * @param job The job (NULL tells a worker to shut down)
+  */
+void submit_job(Job* job){
+  wait_semaphore(&free_jobs);
+  //a cell is counted free once the worker that took its job has let it go,
+  //but the next cell to enqueue into may still be held by a slower worker:
+  //it is let go within a few instructions
+  while(mpmc_enqueue(job_queue, job) != QUEUE_OK) sched_yield();
+  sem_post(&queued_jobs);
+}
+
+/** This function takes the oldest job from the queue, waiting for one when
+  * the queue is empty.
+  * @return The job (NULL tells the worker to shut down)
+  */
+Job* take_job(){
+  wait_semaphore(&queued_jobs);
+  //a job is counted once it is published, but the next cell to dequeue may
+  //have been claimed by a slower thread submitting a job that is not
+  //published yet: it is within a few instructions
+  void* job;
+  while(mpmc_dequeue(job_queue, &job) != QUEUE_OK) sched_yield();
+  sem_post(&free_jobs);
+  return (Job*) job;
+}
+
+/** This function waits for a semaphore, through any signal that stops the
+  * server
+  * @param semaphore The semaphore
+  */
+void wait_semaphore(sem_t* semaphore){
+  while(sem_wait(semaphore) != 0 && errno == EINTR){
+    continue;
+  }
+}
+
+/** This function accepts client connections until the server is stopped
+  * with SIGINT or SIGTERM.
+  * @param port The TCP port to listen on
+  * @return 0 The server was stopped
+  * @return 1 The server could not listen on the port
+  */
+int serve_socket(int port){
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  int reuse = 1;
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  if(listen_fd == -1 ||
+     setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse,
+                sizeof(reuse)) != 0 ||
+     bind(listen_fd, (struct sockaddr*) &address, sizeof(address)) != 0 ||
+     listen(listen_fd, 128) != 0){
+    printf("The server could not listen on port %d.\n", port);
+    return 1;
+  }
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = on_stop_signal; //no SA_RESTART, so accept is woken
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  signal(SIGPIPE, SIG_IGN); //a client that hangs up is handled by write
+
+  if(!start_workers(worker_count, NULL)){
+    printf("The server could not be started.\n");
+    return 1;
+  }
+  fprintf(stderr, "Serving port %d with %d threads.\n", port, worker_count);
+
+  while(!stopping){
+    int fd = accept(listen_fd, NULL, NULL);
+    if(fd == -1) continue; //interrupted, or the client went away
+
+    Connection* connection = (Connection*) malloc(sizeof(Connection));
+    pthread_t thread_id;
+    if(connection == NULL || sem_init(&connection->job.done, 0, 0) != 0){
+      free(connection);
+      close(fd);
+      continue;
+    }
+    connection->fd = fd;
+    if(pthread_create(&thread_id, NULL, connection_main, connection) != 0){
+      sem_destroy(&connection->job.done);
+      free(connection);
+      close(fd);
+      continue;
+    }
+    pthread_detach(thread_id);
+    atomic_fetch_add_explicit(&connections, 1, memory_order_relaxed);
+  }
+
+  close(listen_fd);
+  print_server_stats(stderr);
+  return 0;
+}
+
+/** This function solves stdin, one cube per line, and writes the solutions to
+  * stdout in order. The input is cut into chunks of whole lines; up to two
+  * chunks per worker are solved at once while the oldest is written out.
+  * @param threads The number of worker threads
+  * @return 0 The input was solved
+  * @return 1 The workers could not be started, or out of memory
+  */
+int serve_stdin(int threads){
+  int slots = threads * 2;
+  Job* chunks = (Job*) calloc(slots, sizeof(Job));
+  char* carry = (char*) malloc(CHUNK_SIZE); //partial line after a chunk
+  pthread_t* thread_ids = (pthread_t*) malloc(threads * sizeof(pthread_t));
+  if(chunks == NULL || carry == NULL || thread_ids == NULL) return 1;
+
+  int i;
+  for(i = 0; i < slots; i++){
+    chunks[i].type = JOB_CHUNK;
+    chunks[i].text = (char*) malloc(CHUNK_SIZE + 1);
+    if(chunks[i].text == NULL) return 1;
+    sem_init(&chunks[i].done, 0, 0);
+  }
+  if(!start_workers(threads, thread_ids)){
+    printf("The server could not be started.\n");
+    return 1;
+  }
+
+  char* in_flight = (char*) calloc(slots, 1);
+  size_t carry_size = 0;
+  int skipping = 0; //discarding the rest of a line that is too long
+  int done = 0;
+  int failed = 0;
+  int slot = 0;
+  while(!done){
+    Job* chunk = &chunks[slot];
+    if(in_flight[slot]){ //write out the oldest chunk before reusing it
+      wait_semaphore(&chunk->done);
+      in_flight[slot] = 0;
+      if(chunk->failed){
+        failed = 1;
+        break;
+      }
+      fwrite(chunk->out, 1, chunk->out_size, stdout);
+    }
+
+    memcpy(chunk->text, carry, carry_size);
+    size_t size = carry_size + fread(chunk->text + carry_size, 1,
+                                     CHUNK_SIZE - carry_size, stdin);
+    carry_size = 0;
+    if(size < CHUNK_SIZE){ //end of input
+      done = 1;
+      if(size > 0 && chunk->text[size - 1] != '\n') chunk->text[size++] = '\n';
+    }
+
+    char* text = chunk->text;
+    char* last = (char*) memrchr(text, '\n', size);
+    if(last == NULL){ //a single line longer than a chunk
+      if(!skipping) memcpy(text, "\n", 1); //answered with INVALID
+      size = skipping ? 0 : 1;
+      skipping = 1;
+    }else{
+      carry_size = (text + size) - (last + 1);
+      memcpy(carry, last + 1, carry_size);
+      size = (last + 1) - text;
+      if(skipping){ //drop the end of the long line
+        char* first = (char*) memchr(text, '\n', size);
+        size -= (first + 1) - text;
+        memmove(text, first + 1, size);
+        skipping = 0;
+      }
+    }
+    if(size == 0) continue;
+
+    chunk->text_size = size;
+    in_flight[slot] = 1;
+    submit_job(chunk);
+    slot = (slot + 1) % slots;
+  }
+
+  for(i = 0; i < slots; i++){ //write out the remaining chunks in order
+    Job* chunk = &chunks[(slot + i) % slots];
+    if(!in_flight[(slot + i) % slots]) continue;
+    wait_semaphore(&chunk->done);
+    if(chunk->failed) failed = 1;
+    if(!failed) fwrite(chunk->out, 1, chunk->out_size, stdout);
+  }
+  fflush(stdout);
+  if(failed) fprintf(stderr, "Out of memory for the solutions.\n");
+
+  for(i = 0; i < threads; i++) submit_job(NULL);
+  for(i = 0; i < threads; i++) pthread_join(thread_ids[i], NULL);
+  print_server_stats(stderr);
+
+  for(i = 0; i < slots; i++){
+    free(chunks[i].text);
+    free(chunks[i].out);
+    sem_destroy(&chunks[i].done);
+  }
+  free(chunks);
+  free(carry);
+  free(in_flight);
+  free(thread_ids);
+  return failed;
+}
+
+/** This function is run by the thread of each client connection. It
+  * answers every line the client sends, until it disconnects, and frees the
+  * connection.
+  * @param arg The connection
+  * @return NULL
+  */
+void* connection_main(void* arg){
+  Connection* connection = (Connection*) arg;
+  connection->batch.pending = 0;
+  connection->job.type = JOB_SOLVE;
+  connection->job.batch = &connection->batch;
+  memset(&connection->session, 0, sizeof(SolveSession));
+  connection->session.length = -1; //no session until the client starts one
+  Sink sink = {connection, NULL, -1, 0};
+  LineBatch* batch = &connection->batch;
+  char* in = connection->in;
+  size_t size = 0;
+  int skipping = 0; //discarding the rest of a line that is too long
+
+  while(!sink.failed){
+    ssize_t received = read(connection->fd, in + size, IN_SIZE - size);
+    if(received == -1 && errno == EINTR) continue;
+    if(received <= 0) break;
+    size += received;
+
+    char* last = (char*) memrchr(in, '\n', size);
+    if(last == NULL){
+      if(size == IN_SIZE){ //a single line longer than the buffer
+        if(!skipping) batch->cubes[batch->pending++] = -1;
+        flush_cubes(batch, &sink);
+        skipping = 1;
+        size = 0;
+      }
+      continue;
+    }
+
+    char* text = in;
+    size_t used = (last + 1) - in;
+    if(skipping){ //drop the end of the long line
+      text = (char*) memchr(text, '\n', used) + 1;
+      skipping = 0;
+    }
+    solve_text(batch, &sink, text, (in + used) - text);
+    flush_cubes(batch, &sink); //answer before waiting on the client again
+
+    memmove(in, in + used, size - used);
+    size -= used;
+  }
+
+  flush_cubes(batch, &sink);
+  close(connection->fd);
+  sem_destroy(&connection->job.done);
+  free(connection);
+  return NULL;
+}
+
+/** This function solves whole lines of text
+  * @param batch Where to collect the cubes of the lines
+  * @param sink Where to write the solutions
+  * @param text The lines, the last of which ends with '\n'
+  * @param size The number of bytes of text
+  */
+void solve_text(LineBatch* batch, Sink* sink, char* text, size_t size){
+  char* end = text + size;
+  while(text < end && !sink->failed){
+    char* newline = (char*) memchr(text, '\n', end - text);
+    *newline = '\0';
+
+    if(is_command(text, "METRICS") || is_command(text, "GET /metrics")){
+      flush_cubes(batch, sink); //keep the answers in order
+      int http = (text[0] == 'G');
+      emit_metrics(sink, http);
+      if(http && sink->connection != NULL) sink->failed = 1; //close it
+    }else if(is_command(text, "SESSION") || is_command(text, "TURN")){
+      flush_cubes(batch, sink); //keep the answers in order
+      emit_session(sink, text, text[0] == 'S');
+    }else if(is_command(text, "STATS")){
+      flush_cubes(batch, sink); //keep the answers in order
+      size_t stats_size = 384 + (worker_count * 128);
+      char* stats_text = (char*) malloc(stats_size);
+      if(stats_text != NULL){
+        emit(sink, stats_text, format_server_stats(stats_text, stats_size));
+        free(stats_text);
+      }
+    }else{
+      batch->cubes[batch->pending++] = parse_line(text);
+      if(batch->pending == BATCH_SIZE) flush_cubes(batch, sink);
+    }
+    text = newline + 1;
+  }
+}
+
+/** This function solves the cubes that have been collected and writes out
+  * their solutions. The cubes of a client are handed to a worker, and the
+  * thread of the client waits for them; a worker solving a chunk solves
+  * them itself.
+  * @param batch The cubes
+  * @param sink Where to write the solutions
+  */
+void flush_cubes(LineBatch* batch, Sink* sink){
+  if(batch->pending == 0 || sink->failed) return;
+
+  if(sink->connection != NULL){
+    Job* job = &sink->connection->job;
+    submit_job(job);
+    wait_semaphore(&job->done);
+  }else{
+    solve_cubes(batch, sink->worker);
+  }
+
+  char* end = batch->out;
+  size_t i;
+  for(i = 0; i < batch->pending; i++){
+    end = format_solution(end, &batch->solutions[i * SOLUTION_SIZE]);
+  }
+  batch->pending = 0;
+
+  emit(sink, batch->out, end - batch->out);
+}
+
+/** This function solves a batch of cubes, and adds them to the throughput
+  * of the worker solving them
+  * @param batch The cubes, whose solutions are filled in
+  * @param worker_id The worker
+  */
+void solve_cubes(LineBatch* batch, int worker_id){
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  if(server_cache != NULL){
+    cache_solve_batch(server_cache, batch->cubes, batch->pending,
+                      server_table, batch->solutions);
+  }else{
+    solve_batch(batch->cubes, batch->pending, server_table,
+                batch->solutions);
+  }
+
+  WorkerStats* worker_stats = &stats[worker_id];
+  atomic_fetch_add_explicit(&worker_stats->busy_ns,
+                            (unsigned long long) (seconds_since(&start) * 1e9),
+                            memory_order_relaxed);
+  atomic_fetch_add_explicit(&worker_stats->cubes, batch->pending,
+                            memory_order_relaxed);
+}
+
+/** This function writes solutions to a client, or appends them to a chunk.
+  * A client that cannot be written to, or a chunk that cannot grow, fails
+  * the sink: the connection is closed, or the chunk is reported as failed.
+  * @param sink Where to write
+  * @param data The bytes to write
+  * @param size The number of bytes
+  * @return 1 The bytes were written
+  * @return 0 The sink has failed
+  */
+int emit(Sink* sink, const char* data, size_t size){
+  if(sink->failed) return 0;
+  if(sink->job != NULL){
+    Job* job = sink->job;
+    if(job->out_size + size > job->out_capacity){
+      size_t capacity = job->out_capacity * 2;
+      if(capacity < job->out_size + size) capacity = job->out_size + size;
+      char* out = (char*) realloc(job->out, capacity);
+      if(out == NULL){
+        sink->failed = 1; //out of memory
+        return 0;
+      }
+      job->out = out;
+      job->out_capacity = capacity;
+    }
+    memcpy(job->out + job->out_size, data, size);
+    job->out_size += size;
+    return 1;
+  }
+
+  while(size > 0 && !sink->failed){
+    ssize_t sent = write(sink->connection->fd, data, size);
+    if(sent == -1){
+      if(errno != EINTR) sink->failed = 1;
+      continue;
+    }
+    data += sent;
+    size -= sent;
+  }
+  return !sink->failed;
+}
+
+/** This function writes out the metrics of the solver (see format_metrics)
+  * @param sink Where to write
+  * @param http 1 to write them as an HTTP response, 0 followed by METRICS END
+  */
+void emit_metrics(Sink* sink, int http){
+  char* text = (char*) malloc(METRICS_TEXT_SIZE);
+  if(text == NULL) return;
+  size_t size = format_metrics(text, METRICS_TEXT_SIZE);
+  if(http){
+    char header[160];
+    int header_size = snprintf(header, sizeof(header),
+                               "HTTP/1.0 200 OK\r\n"
+                               "Content-Type: text/plain; version=0.0.4\r\n"
+                               "Content-Length: %zu\r\n"
+                               "Connection: close\r\n\r\n", size);
+    emit(sink, header, header_size);
+    emit(sink, text, size);
+  }else{
+    emit(sink, text, size);
+    emit(sink, "METRICS END\n", 12);
+  }
+  free(text);
+}
+
+/** This function answers a SESSION or a TURN line with the solution of the
+  * cube of the session after it
+  * @param sink Where to write the solution (and the client, whose session it
+  *    is)
+  * @param text The line
+  * @param start 1 SESSION (text holds a cube), 0 TURN (text holds a turn)
+  */
+void emit_session(Sink* sink, const char* text, int start){
+  char solution[SOLUTION_SIZE] = {-1, 0};
+  char line[OUTPUT_LINE_SIZE];
+  SolveSession* session = (sink->connection != NULL) ?
+                           &sink->connection->session : NULL;
+  if(session != NULL){
+    int valid;
+    if(start){
+      char cube_text[LINE_SIZE];
+      strncpy(cube_text, text + 7, LINE_SIZE - 1); //after "SESSION"
+      cube_text[LINE_SIZE - 1] = '\0';
+      int cube = parse_line(cube_text);
+      if(cube == -1) session->length = -1;
+      valid = cube != -1 && start_session(session, server_table, cube) != -1;
+    }else{
+      valid = session_turn(session, parse_turn(text + 4)) != -1; //after TURN
+    }
+    if(valid) session_solution(session, solution);
+  }
+  emit(sink, line, format_solution(line, solution) - line);
+}
+
+/** This function checks if a line is a command: the command, followed by
+  * the end of the line, a carriage return or a space (an HTTP request).
+  * @param line The line
+  * @param command The command
+  * @return 1 The line is the command
+  * @return 0 It is not
+  */
+int is_command(const char* line, const char* command){
+  size_t length = strlen(command);
+  if(strncmp(line, command, length) != 0) return 0;
+  return line[length] == '\0' || line[length] == '\r' || line[length] == ' ';
+}
+
+/** This function writes the thread count and the throughput of each worker
+  * @param out Where to write the text
+  * @param size The size of out (384 + 128 per worker is enough)
+  * @return The number of chars written
+  */
+size_t format_server_stats(char* out, size_t size){
+  double uptime = seconds_since(&start_time);
+  unsigned long long total = 0;
+  int i;
+  for(i = 0; i < worker_count; i++){
+    total += atomic_load_explicit(&stats[i].cubes, memory_order_relaxed);
+  }
+
+  size_t used = snprintf(out, size,
+                         "STATS threads=%d uptime_s=%.3f cubes=%llu "
+                         "cubes_per_s=%.0f connections=%llu\n", worker_count,
+                         uptime, total, uptime > 0 ? total / uptime : 0.0,
+                         atomic_load_explicit(&connections,
+                                              memory_order_relaxed));
+  for(i = 0; i < worker_count && used < size; i++){
+    unsigned long long cubes = atomic_load_explicit(&stats[i].cubes,
+                                                    memory_order_relaxed);
+    double busy = atomic_load_explicit(&stats[i].busy_ns,
+                                       memory_order_relaxed) / 1e9;
+    used += snprintf(out + used, size - used,
+                     "STATS worker=%d cubes=%llu busy_s=%.3f "
+                     "cubes_per_busy_s=%.0f\n", i, cubes, busy,
+                     busy > 0 ? cubes / busy : 0.0);
+  }
+  if(server_cache != NULL && used < size){
+    used += format_cache_stats(server_cache, out + used, size - used);
+  }
+  if(used < size) used += snprintf(out + used, size - used, "STATS END\n");
+  return (used < size) ? used : size - 1;
+}
+
+/** This function returns the time that has passed since start
+  * @param start The start time (CLOCK_MONOTONIC)
+  * @return The number of seconds since start
+  */
+double seconds_since(const struct timespec* start){
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + ((now.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/** This function stops the server when SIGINT or SIGTERM is received
+  * @param signal_number The signal
+  */
+void on_stop_signal(int signal_number){
+  (void) signal_number;
+  stopping = 1;
+}
@@ -0,0 +1,19 @@
+/** File: server.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file server.c
+  */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include "table_file.h"
+#include "solution_cache.h"
+
+//Function Prototypes
+int run_server(const StateTable* table, SolutionCache* cache, int port,
+               int threads);
+void print_server_stats(FILE* out);
+
+#endif
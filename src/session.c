@@ -0,0 +1,148 @@
+/** File: session.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the solve sessions (see session.h), which follow the
+  * turns a user makes on a cube and keep a shortest solution of it, without
+  * solving the cube again after every turn.
+  *
+  * Every turn changes the depth of the cube by exactly one. Following the
+  * solution, or undoing the turns of it that were made, needs no lookup at
+  * all. Any other turn costs one table lookup on the new cube: when the
+  * table's turn undoes the user's turn, the cube is one turn further away
+  * and that turn is put in front of the solution. Otherwise the user found
+  * another way in, and the cube is solved again (see
+  * table_solve_cube_into).
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "session.h"
+#include "cube.h"
+
+//the turn that undoes a turn (1 <-> 2, 3 <-> 4, 5 <-> 6)
+#define inverse_turn(turn) ((((turn) - 1) ^ 1) + 1)
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+int solve_session(SolveSession* session);
+int push_turn(SolveSession* session, int turn);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Session Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function starts a session on a cube, and solves it
+  * @param session The session to fill
+  * @param table The loaded table (of any encoding)
+  * @param cube The integer representation of the cube
+  * @return The number of turns in the solution
+  * @return -1 The cube is invalid
+  */
+int start_session(SolveSession* session, const StateTable* table, int cube){
+  session->table = table;
+  session->cube = cube;
+  session->solves = 0;
+  return solve_session(session);
+}
+
+/** This function makes a turn on the cube of a session, and updates its
+  * solution.
+  * @param session The session
+  * @param turn The turn (1 - 6, as in the solutions of solve_cube)
+  * @return The number of turns left in the solution
+  * @return -1 The turn is not valid, or the session has no valid cube
+  */
+int session_turn(SolveSession* session, int turn){
+  if(turn < 1 || turn > 6 || session->length < 0) return -1;
+  session->cube = rotate(session->cube, turn - 1);
+
+  char* turns = session->turns;
+  int top = session->length;
+  if(top > 0 && turns[top - 1] == turn){ //followed the solution
+    session->length--;
+    session->followed++;
+  }else if(session->followed > 0 && turns[top] == inverse_turn(turn)){
+    session->length++; //undid a turn of the solution
+    session->followed--;
+  }else{
+    char next = table_get_turn(session->table, session->cube);
+    if(next == inverse_turn(turn)) return push_turn(session, next);
+    return solve_session(session); //another way in
+  }
+  return session->length;
+}
+
+/** This function returns the next turn of the solution of a session
+  * @param session The session
+  * @return The turn (1 - 6)
+  * @return 0 The cube is solved
+  * @return -1 The session has no valid cube
+  */
+char session_next_turn(const SolveSession* session){
+  if(session->length < 0) return -1;
+  return (session->length == 0) ? 0 : session->turns[session->length - 1];
+}
+
+/** This function writes out the solution of a session
+  * @param session The session
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns (as
+  *    returned by solve_cube, the single turn -1 when the cube is invalid)
+  * @return The number of turns in the solution
+  * @return -1 The session has no valid cube
+  */
+int session_solution(const SolveSession* session, char* turn_sequence){
+  if(session->length < 0){
+    turn_sequence[0] = -1;
+    turn_sequence[1] = 0;
+    return -1;
+  }
+  int i;
+  for(i = 0; i < session->length; i++){
+    turn_sequence[i] = session->turns[session->length - 1 - i];
+  }
+  turn_sequence[session->length] = 0;
+  return session->length;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function solves the cube of a session from scratch
+  * @param session The session
+  * @return The number of turns in the solution
+  * @return -1 The cube is invalid
+  */
+int solve_session(SolveSession* session){
+  char solution[SOLUTION_SIZE];
+  session->solves++;
+  session->followed = 0;
+  if(table_solve_cube_into(session->table, session->cube, solution) == -1){
+    session->length = -1;
+    return -1;
+  }
+  int length = 0;
+  while(solution[length] != 0) length++;
+  int i;
+  for(i = 0; i < length; i++) session->turns[i] = solution[length - 1 - i];
+  session->length = length;
+  return length;
+}
+
+/** This function puts a turn in front of the solution of a session. It
+  * overwrites the turns that could be undone.
+  * @param session The session
+  * @param turn The turn
+  * @return The number of turns in the solution
+  * @return -1 The cube is invalid
+  */
+int push_turn(SolveSession* session, int turn){
+  //only a table that is not optimal could need more turns than that
+  if(session->length == SOLUTION_SIZE - 1) return solve_session(session);
+  session->turns[session->length++] = turn;
+  session->followed = 0;
+  return session->length;
+}
@@ -0,0 +1,37 @@
+/** File: session.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the solve session structure and the function
+  * prototypes for the file session.c
+  */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "table_file.h"
+#include "state_table.h"
+
+/** A cube being solved one turn at a time, with a shortest solution of the
+  * cube that is kept up to date as turns are made. The turns are held as a
+  * stack: turns[length - 1] is the next turn of the solution, and the turns
+  * above the top (turns[length] up to turns[length + followed - 1]) are the
+  * turns of the solution that were made, the most recent first, so they can
+  * be undone. A session is owned by the caller (EX: on the stack) and needs
+  * no memory of its own.
+  */
+typedef struct SolveSession {
+  const StateTable* table;      //solves the cube
+  int cube;                     //the cube as it is now
+  char turns[SOLUTION_SIZE];    //the solution, last turn first
+  int length;                   //the number of turns left in the solution
+  int followed;                 //the turns of the solution that can be undone
+  int solves;                   //the times the cube was solved from scratch
+} SolveSession;
+
+//Function Prototypes
+int start_session(SolveSession* session, const StateTable* table, int cube);
+int session_turn(SolveSession* session, int turn);
+char session_next_turn(const SolveSession* session);
+int session_solution(const SolveSession* session, char* turn_sequence);
+
+#endif
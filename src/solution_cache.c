@@ -0,0 +1,251 @@
+/** File: solution_cache.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the solution cache, which sits in front of the table
+  * solvers and remembers the solutions of the cubes asked for most recently.
+  *
+  * A solution has at most 14 turns and each turn fits in 3 bits, so the turns
+  * take 42 bits of a 64 bit word and the rank of the cube (22 bits) fits in
+  * the rest. A slot is that one word: the turns of a packed solution (see
+  * packed_solution.h) without its length, under the rank. It is written with
+  * a single atomic store, and a reader that loads a slot either sees a whole
+  * entry for its rank or a different rank (a miss). No locks are taken and a
+  * slot that is overwritten by another thread is simply a miss on the next
+  * lookup.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "solution_cache.h"
+#include "packed_solution.h"
+#include "state_table.h"
+#include "cube.h"
+
+#define MIN_CACHE_SLOTS 64
+#define TURN_BITS SOLUTION_TURN_BITS
+#define TURNS_BITS (TURN_BITS * PACKED_SOLUTION_TURNS) //42 bits of turns
+#define TURNS_MASK ((((uint64_t) 1) << TURNS_BITS) - 1)
+#define EMPTY_SLOT (~((uint64_t) 0)) //rank 0x3FFFFF is never a cube
+#define SLOT_HASH 0x9E3779B97F4A7C15ULL //2^64 / golden ratio
+#define CACHE_BATCH 256 //misses solved per call to solve_batch
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+size_t slot_of(const SolutionCache* cache, int rank);
+void count_lookup(SolutionCache* cache, size_t slot, int hit);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Solution Cache Functions ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates an empty solution cache.
+  * @param slots The number of solutions to keep (rounded up to a power of 2)
+  * @return The cache
+  * @return NULL The cache could not be allocated
+  */
+SolutionCache* create_solution_cache(size_t slots){
+  SolutionCache* cache = (SolutionCache*) calloc(1, sizeof(SolutionCache));
+  if(cache == NULL) return NULL;
+
+  cache->slots = MIN_CACHE_SLOTS;
+  cache->shift = 64 - 6;
+  while(cache->slots < slots && cache->shift > 32){
+    cache->slots *= 2;
+    cache->shift--;
+  }
+  cache->entries = (_Atomic uint64_t*) malloc(cache->slots * sizeof(uint64_t));
+  if(cache->entries == NULL){
+    free(cache);
+    return NULL;
+  }
+  size_t i;
+  for(i = 0; i < cache->slots; i++){
+    atomic_init(&cache->entries[i], EMPTY_SLOT);
+  }
+  return cache;
+}
+
+/** This function frees a solution cache
+  * @param cache The cache (or NULL)
+  */
+void free_solution_cache(SolutionCache* cache){
+  if(cache == NULL) return;
+  free((void*) cache->entries);
+  free(cache);
+}
+
+/** This function looks up the solution of a cube, and counts the hit or miss.
+  * @param cache The cache
+  * @param rank The rank of the cube (see rank_cube)
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0) on a hit
+  * @return The number of turns
+  * @return -1 The cube is not in the cache
+  */
+int cache_lookup(SolutionCache* cache, int rank, char* turn_sequence){
+  size_t slot = slot_of(cache, rank);
+  uint64_t entry = atomic_load_explicit(&cache->entries[slot],
+                                        memory_order_relaxed);
+  if((entry >> TURNS_BITS) != (uint64_t) rank){
+    count_lookup(cache, slot, 0);
+    return -1;
+  }
+  count_lookup(cache, slot, 1);
+
+  //the turns are never 0, so the highest used 3 bits give the length
+  uint64_t turns = entry & TURNS_MASK;
+  int length = (turns == 0) ? 0 :
+               (64 - __builtin_clzll(turns) + TURN_BITS - 1) / TURN_BITS;
+  return unpack_solution((turns << SOLUTION_LENGTH_BITS) | length,
+                         turn_sequence);
+}
+
+/** This function stores the solution of a cube, replacing whatever cube was
+  * in its slot.
+  * @param cache The cache
+  * @param rank The rank of the cube (see rank_cube)
+  * @param turn_sequence The turns that solve the cube, ending with 0
+  */
+void cache_insert(SolutionCache* cache, int rank, const char* turn_sequence){
+  PackedSolution solution = pack_solution(turn_sequence);
+  if(solution == PACKED_SOLUTION_INVALID) return;
+  uint64_t entry = (solution >> SOLUTION_LENGTH_BITS) |
+                   (((uint64_t) rank) << TURNS_BITS);
+  atomic_store_explicit(&cache->entries[slot_of(cache, rank)], entry,
+                        memory_order_relaxed);
+}
+
+/** This function solves a cube with a table of any encoding, using the
+  * cache when the cube was solved recently.
+  * @param cache The cache
+  * @param table The loaded table
+  * @param cube The cube to be solved
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int cache_solve_cube_into(SolutionCache* cache, const StateTable* table,
+                          int cube, char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1; //signal an invalid cube
+
+  int count = cache_lookup(cache, rank, turn_sequence);
+  if(count != -1) return count;
+  count = table_solve_cube_into(table, cube, turn_sequence);
+  if(count != -1) cache_insert(cache, rank, turn_sequence);
+  return count;
+}
+
+/** This function solves a batch of cubes (see solve_batch), answering the
+  * cubes in the cache from the cache and solving the rest together.
+  * @param cache The cache
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param table The loaded table
+  * @param solutions n * SOLUTION_SIZE chars, filled with the turns for each 
+  *    cube. An invalid cube is given the single turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t cache_solve_batch(SolutionCache* cache, const int* cubes, size_t n,
+                         const StateTable* table, char* solutions){
+  int misses[CACHE_BATCH];
+  int miss_ranks[CACHE_BATCH];
+  size_t miss_index[CACHE_BATCH];
+  char miss_solutions[CACHE_BATCH * SOLUTION_SIZE];
+  size_t solved = 0;
+  size_t i = 0;
+  while(i < n){
+    size_t missed = 0;
+    for(; i < n && missed < CACHE_BATCH; i++){
+      char* solution = &solutions[i * SOLUTION_SIZE];
+      int rank = rank_cube(cubes[i]);
+      if(rank == -1){
+        memset(solution, 0, SOLUTION_SIZE);
+        solution[0] = -1;
+      }else if(cache_lookup(cache, rank, solution) != -1){
+        solved++;
+      }else{
+        misses[missed] = cubes[i];
+        miss_ranks[missed] = rank;
+        miss_index[missed++] = i;
+      }
+    }
+
+    solved += solve_batch(misses, missed, table, miss_solutions);
+    size_t j;
+    for(j = 0; j < missed; j++){
+      char* solution = &miss_solutions[j * SOLUTION_SIZE];
+      memcpy(&solutions[miss_index[j] * SOLUTION_SIZE], solution,
+             SOLUTION_SIZE);
+      if(solution[0] != -1) cache_insert(cache, miss_ranks[j], solution);
+    }
+  }
+  return solved;
+}
+
+/** This function adds up the hit and miss counters of every shard
+  * @param cache The cache
+  * @param hits Set to the number of lookups that found their cube
+  * @param misses Set to the number of lookups that did not
+  */
+void cache_counts(const SolutionCache* cache, unsigned long long* hits,
+                  unsigned long long* misses){
+  *hits = 0;
+  *misses = 0;
+  int i;
+  for(i = 0; i < CACHE_SHARDS; i++){
+    *hits += atomic_load_explicit(&cache->shards[i].hits,
+                                  memory_order_relaxed);
+    *misses += atomic_load_explicit(&cache->shards[i].misses,
+                                    memory_order_relaxed);
+  }
+}
+
+/** This function writes the size and the counters of the cache as one line
+  * @param cache The cache
+  * @param out Where to write the text
+  * @param size The size of out (128 is enough)
+  * @return The number of chars written
+  */
+size_t format_cache_stats(const SolutionCache* cache, char* out, size_t size){
+  unsigned long long hits, misses;
+  cache_counts(cache, &hits, &misses);
+  unsigned long long lookups = hits + misses;
+  size_t used = snprintf(out, size,
+                         "STATS cache slots=%zu hits=%llu misses=%llu "
+                         "hit_rate=%.3f\n", cache->slots, hits, misses,
+                         lookups > 0 ? (double) hits / lookups : 0.0);
+  return (used < size) ? used : size - 1;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function returns the slot of a rank. The rank is multiplied by the
+  * golden ratio so that neighbouring ranks spread over the whole cache.
+  * @param cache The cache
+  * @param rank The rank of the cube
+  * @return The slot (0 - slots - 1)
+  */
+size_t slot_of(const SolutionCache* cache, int rank){
+  return (size_t) ((((uint64_t) rank) * SLOT_HASH) >> cache->shift);
+}
+
+/** This function counts a lookup in the shard of its slot
+  * @param cache The cache
+  * @param slot The slot that was looked up
+  * @param hit 1 The cube was found, 0 it was not
+  */
+void count_lookup(SolutionCache* cache, size_t slot, int hit){
+  CacheShard* shard = &cache->shards[slot & (CACHE_SHARDS - 1)];
+  atomic_fetch_add_explicit(hit ? &shard->hits : &shard->misses, 1,
+                            memory_order_relaxed);
+}
@@ -0,0 +1,51 @@
+/** File: solution_cache.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the cache structure and the function prototypes for the
+  * file solution_cache.c
+  */
+
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "table_file.h"
+
+#define CACHE_SHARDS 16 //the counters are kept per shard, on their own lines
+#define DEFAULT_CACHE_SLOTS 65536 //slots used when no size is given
+
+//the hit and miss counters of one shard (one cache line each)
+typedef struct CacheShard {
+  atomic_ullong hits;
+  atomic_ullong misses;
+  char pad[64 - (2 * sizeof(atomic_ullong))];
+} CacheShard;
+
+/** A fixed size, direct mapped cache from a cube to its solution. Each slot
+  * is one 64 bit word holding the rank of the cube and its packed turns, so
+  * the slots are read and written with single atomic loads and stores and
+  * any number of threads can share the cache without a lock.
+  */
+typedef struct SolutionCache {
+  size_t slots;                 //number of slots (a power of 2)
+  int shift;                    //64 - log2(slots), for the slot hash
+  _Atomic uint64_t* entries;    //the slots
+  CacheShard shards[CACHE_SHARDS];
+} SolutionCache;
+
+//Function Prototypes
+SolutionCache* create_solution_cache(size_t slots);
+void free_solution_cache(SolutionCache* cache);
+int cache_lookup(SolutionCache* cache, int rank, char* turn_sequence);
+void cache_insert(SolutionCache* cache, int rank, const char* turn_sequence);
+int cache_solve_cube_into(SolutionCache* cache, const StateTable* table,
+                          int cube, char* turn_sequence);
+size_t cache_solve_batch(SolutionCache* cache, const int* cubes, size_t n,
+                         const StateTable* table, char* solutions);
+void cache_counts(const SolutionCache* cache, unsigned long long* hits,
+                  unsigned long long* misses);
+size_t format_cache_stats(const SolutionCache* cache, char* out, size_t size);
+
+#endif
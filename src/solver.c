@@ -7,34 +7,169 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
 #include "cube.h"
 #include "state_table.h"  
+#include "table_file.h"
+#include "parse.h"
+#include "server.h"
+#include "parallel_table.h"
+#include "depth_table.h"
+#include "symmetry_table.h"
+#include "solution_cache.h"
+#include "search.h"
+#include "metrics.h"
+#include "verify.h"
+#include "scramble.h"
+#include "puzzle.h"
+
+#define STREAM_BATCH 4096 //cubes solved per call to solve_batch
+
+static StateTable* state_table; //global variable (local to file)
+static SolutionCache* solution_cache = NULL; //solver -c, NULL without it
 
-#define BUFF_SIZE 24
-#define c21_6 (85766121)
-#define c21_5 (4084101)
-#define c21_4 (194481)
-#define c21_3 (9261)
-#define c21_2 (441)
-#define c21_1 (21)
-#define c21_0 (1)
+void print_intro();
+int fill_buffer(char* buffer);
+void print_metrics_at_exit();
+
+int load_tables(const char* file_name, int lazy, int indexed);
+int generate_tables(int threads);
+int solve_stream(const char* file_name, int notation);
+int depth_stream(const char* file_name);
+int scramble_stream(long count, int depth, uint64_t seed);
+int puzzle_stream(const char* name, const char* file_name);
+
+int main(int argc, char** argv){
+  if(argc > 1 && strcmp(argv[1], "-m") == 0){
+    //solver -m ...: print the metrics to stderr when done (make METRICS=1)
+    atexit(print_metrics_at_exit);
+    argv++;
+    argc--;
+  }
 
-extern char state_table0356[21][3];
-extern char state_table1247[21][3];
+  const char* table_name = NULL;
+  if(argc > 2 && strcmp(argv[1], "-t") == 0){
+    //solver -t file ...: solve with the table in file (EX: symmetry_table.bin)
+    table_name = argv[2];
+    argv += 2;
+    argc -= 2;
+  }
 
-static char* state_table; //global variable (local to file)
+  int engine = 0;
+  if(argc > 2 && strcmp(argv[1], "-e") == 0){
+    //solver -e ida|search ...: solve by search instead of with a table
+    if(strcmp(argv[2], "ida") == 0) engine = TABLE_IDA;
+    else if(strcmp(argv[2], "search") == 0) engine = TABLE_SEARCH;
+    else{
+      printf("Unknown engine %s (use ida or search).\n", argv[2]);
+      return 1;
+    }
+    argv += 2;
+    argc -= 2;
+  }
 
-void print_intro();
-int fill_buffer(char* buffer);
-int compress(char* buffer);
-char which_piece(char* piece);
-char contains(char character, char* piece);
-char get_piece_state(char piece, char pos, char* piece_orientation);
-char compare_pieces(char* piece1, char* piece2);
+  int lazy = 0;
+  if(argc > 1 && strcmp(argv[1], "-l") == 0){
+    //solver -l ...: do not wait for a table, solve by search until it is built
+    lazy = 1;
+    argv++;
+    argc--;
+  }
 
-int main(){
-  state_table = make_state_table();//initialize table
-  read_state_table(state_table);//load table 
+  int indexed = 0;
+  if(argc > 1 && strcmp(argv[1], "-i") == 0){
+    //solver -i ...: solve with the sorted table (state_table.bin, or the -t
+    //file) as it is, indexed (about 20 MB) for faster lookups
+    indexed = 1;
+    argv++;
+    argc--;
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-c") == 0){
+    //solver -c [slots] ...: remember recent solutions in a solution cache
+    size_t slots = DEFAULT_CACHE_SLOTS;
+    int skip = 1;
+    if(argc > 2 && argv[2][0] >= '0' && argv[2][0] <= '9'){
+      slots = strtoul(argv[2], NULL, 10);
+      skip = 2;
+    }
+    solution_cache = create_solution_cache(slots);
+    if(solution_cache == NULL){
+      printf("Could not allocate the solution cache.\n");
+      return 1;
+    }
+    argv += skip;
+    argc -= skip;
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-g") == 0){
+    //solver -g [threads]: build the tables and exit
+    return generate_tables((argc > 2) ? atoi(argv[2]) : 0);
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-d") == 0){
+    //solver -d [file]: print the depth and every optimal move for each line
+    return depth_stream(argc > 2 ? argv[2] : NULL);
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-p") == 0){
+    //solver -p puzzle [file]: like -b, but for a variant of the cube (EX:
+    //htm, with half turns), solver -p lists them
+    return puzzle_stream(argc > 2 ? argv[2] : NULL, argc > 3 ? argv[3] : NULL);
+  }
+
+  if(engine != 0) state_table = open_search_table(engine);
+  if(engine != 0 ? state_table == NULL :
+                   !load_tables(table_name, lazy, indexed)){
+    printf("Could not load the state table.\n");
+    return 1;
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-b") == 0){
+    //solver -b [file]: solve one cube per line from the file (or stdin)
+    return solve_stream(argc > 2 ? argv[2] : NULL, 0);
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-n") == 0){
+    //solver -n [file]: like -b, but the turns are written as F F' L L' U U'
+    return solve_stream(argc > 2 ? argv[2] : NULL, 1);
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-v") == 0){
+    //solver -v [threads]: check the table solves every cube optimally
+    int threads = (argc > 2) ? atoi(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if(!verify_state_table(state_table)){
+      printf("The checksum of the state table does not match its data.\n");
+      return 1;
+    }
+    VerifyReport report;
+    int passed = verify_table(state_table, threads, &report);
+    if(passed == -1){
+      printf("Could not allocate the verification.\n");
+      return 1;
+    }
+    print_verify_report(stdout, &report);
+    return passed ? 0 : 1;
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-r") == 0){
+    //solver -r [count] [depth] [seed]: print uniformly random cubes, each
+    //with a shortest scramble (depth -1 is any depth)
+    long count = (argc > 2) ? atol(argv[2]) : 1;
+    int depth = (argc > 3) ? atoi(argv[3]) : SCRAMBLE_ANY_DEPTH;
+    uint64_t seed = (argc > 4) ? strtoull(argv[4], NULL, 10) :
+                    (uint64_t) time(NULL);
+    return scramble_stream(count, depth, seed);
+  }
+
+  if(argc > 1 && strcmp(argv[1], "-s") == 0){
+    //solver -s [port] [threads]: serve cubes on a port (0 = stdin)
+    int port = (argc > 2) ? atoi(argv[2]) : 0;
+    int threads = (argc > 3) ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    return run_server(state_table, solution_cache, port, threads);
+  }
 
   print_intro(); //Provide instructions of how to format data entry
   //data will be a string of length 24
@@ -47,12 +182,14 @@ int main(){
   }; //loop until the user enters valid data
 
   int cube = compress(buffer);
+  Cube entered_cube;
+  decompress_into(cube, &entered_cube);
   printf("The cube you entered is:\n\n");
-  print_cube(decompress(cube));
+  print_cube(&entered_cube);
 
-  char* turn_sequence = solve_cube(cube, state_table);
+  char turn_sequence[SOLUTION_SIZE];
   
-  if(turn_sequence == NULL){
+  if(table_solve_cube_into(state_table, cube, turn_sequence) == -1){
     printf("Something went wrong\n");  
     return 1; //signal failure
   }
@@ -85,6 +222,306 @@ int main(){
 
 }
 
+/** This function loads the state table (see load_state_table)
+  * @param file_name A table file to load instead (of any encoding), or NULL
+  * @param lazy 1 to use a lazy table unless ranked_table.bin can be mapped
+  * @param indexed 1 to keep the sorted table (state_table.bin, unless
+  *    file_name is given) instead of the ranked table, and index it (see
+  *    index_state_table)
+  * @return 1 A table was loaded
+  * @return 0 No table could be loaded
+  */
+int load_tables(const char* file_name, int lazy, int indexed){
+  if(indexed && file_name == NULL) file_name = "state_table.bin";
+  state_table = load_state_table(file_name, lazy);
+  if(state_table != NULL && indexed && !index_state_table(state_table)){
+    fprintf(stderr, "There is no memory to index the state table, it is "
+                    "searched without one.\n");
+  }
+  return state_table != NULL;
+}
+
+/** This function generates the ranked table and the sorted state table, and 
+  * writes them to ranked_table.bin and state_table.bin. The depth table, the
+  * mod 3 table and the symmetry table are written to depth_table.bin, 
+  * mod3_table.bin and symmetry_table.bin.
+  * @param threads The number of threads for the parallel generator, or 0 for
+  *    the sequential generator (which reproduces the original state_table.bin)
+  * @return 0 The tables were written
+  * @return 1 The tables could not be generated
+  */
+int generate_tables(int threads){
+  uint64_t* ranked_table = make_ranked_table();
+  unsigned char* sorted_table = make_state_table();
+  if(ranked_table == NULL || sorted_table == NULL ||
+     !(threads > 0 ? generate_ranked_table_parallel(ranked_table, threads)
+                   : generate_ranked_table(ranked_table)) ||
+     !sort_ranked_table(ranked_table, sorted_table)){
+    printf("The state tables could not be generated.\n");
+    return 1;
+  }
+  write_ranked_table(ranked_table);
+  write_state_table(sorted_table);
+  free(sorted_table);
+
+  uint64_t* symmetry_table = make_symmetry_table();
+  if(symmetry_table == NULL ||
+     !reduce_ranked_table(ranked_table, symmetry_table)){
+    printf("The symmetry table could not be generated.\n");
+    free(symmetry_table);
+    free(ranked_table);
+    return 1;
+  }
+  write_symmetry_table(symmetry_table);
+  free(symmetry_table);
+  free(ranked_table);
+
+  uint8_t* depth_table = make_depth_table();
+  if(depth_table == NULL || !generate_depth_table(depth_table)){
+    printf("The depth table could not be generated.\n");
+    free(depth_table);
+    return 1;
+  }
+  write_depth_table(depth_table);
+
+  uint8_t* mod3_table = make_mod3_table();
+  if(mod3_table == NULL || !reduce_depth_table(depth_table, mod3_table)){
+    printf("The mod 3 table could not be generated.\n");
+    free(mod3_table);
+    free(depth_table);
+    return 1;
+  }
+  write_mod3_table(mod3_table);
+  free(mod3_table);
+  free(depth_table);
+  return 0;
+}
+
+/** This function solves a stream of cubes, one per line, and writes one 
+  * solution per line to stdout. A line holds either the 24 colors of the
+  * cube (as entered in the interactive mode, spaces are optional) or the
+  * integer representation of the cube (decimal, or hex starting with 0x).
+  * Each solution is written as its turns seperated by spaces; a solved cube
+  * gives an empty line and an invalid cube gives the line INVALID. With a
+  * solution cache (solver -c), its hits and misses are written to stderr.
+  * @param file_name The file to read, or NULL to read stdin
+  * @param notation 1 to write the turns in the standard notation from packed
+  *    solutions (see format_packed_solution), 0 to write FCC FC...
+  * @return 0 The stream was solved
+  * @return 1 The file could not be read
+  */
+int solve_stream(const char* file_name, int notation){
+  FILE* in = (file_name == NULL) ? stdin : fopen(file_name, "r");
+  if(in == NULL){
+    printf("An error occured while reading from %s.\n", file_name);
+    return 1;
+  }
+
+  static int cubes[STREAM_BATCH];
+  static char solutions[STREAM_BATCH * SOLUTION_SIZE];
+  static char out[STREAM_BATCH * OUTPUT_LINE_SIZE];
+  char line[LINE_SIZE];
+  int done = 0;
+  while(!done){
+    size_t n = 0;
+    while(n < STREAM_BATCH){
+      if(fgets(line, LINE_SIZE, in) == NULL){
+        done = 1;
+        break;
+      }
+      if(strchr(line, '\n') == NULL && !feof(in)){
+        int c;
+        while((c = getc(in)) != '\n' && c != EOF){}; //line too long
+        line[0] = '\0';
+      }
+      cubes[n++] = parse_line(line);
+    }
+
+    if(solution_cache != NULL){
+      cache_solve_batch(solution_cache, cubes, n, state_table, solutions);
+    }else{
+      solve_batch(cubes, n, state_table, solutions);
+    }
+
+    char* end = out;
+    size_t i;
+    for(i = 0; i < n; i++){
+      char* solution = &solutions[i * SOLUTION_SIZE];
+      if(notation) end = format_packed_solution(end, pack_solution(solution));
+      else end = format_solution(end, solution);
+    }
+    fwrite(out, 1, end - out, stdout);
+  }
+
+  if(in != stdin) fclose(in);
+  fflush(stdout);
+  if(solution_cache != NULL){ //the hit rate of the stream
+    format_cache_stats(solution_cache, line, LINE_SIZE);
+    fputs(line, stderr);
+  }
+  return 0;
+}
+
+/** This function reads a stream of cubes, one per line (see solve_stream), 
+  * and writes the depth of each cube followed by every optimal first move.
+  * The depth table is read from depth_table.bin, and generated (and saved) 
+  * when that file does not exist.
+  * @param file_name The file to read, or NULL to read stdin
+  * @return 0 The stream was read
+  * @return 1 The file or the depth table could not be read
+  */
+int depth_stream(const char* file_name){
+  const uint8_t* depth_table;
+  uint8_t* made_table = NULL;
+  StateTable* table = open_state_table("depth_table.bin", 0);
+  if(table != NULL && table->encoding == TABLE_DEPTH){
+    depth_table = (const uint8_t*) table->data;
+  }else{
+    made_table = make_depth_table();
+    if(made_table == NULL || !generate_depth_table(made_table)){
+      printf("The depth table could not be generated.\n");
+      return 1;
+    }
+    write_depth_table(made_table);
+    depth_table = made_table;
+  }
+
+  FILE* in = (file_name == NULL) ? stdin : fopen(file_name, "r");
+  if(in == NULL){
+    printf("An error occured while reading from %s.\n", file_name);
+    return 1;
+  }
+
+  char line[LINE_SIZE];
+  char out[OUTPUT_LINE_SIZE];
+  while(fgets(line, LINE_SIZE, in) != NULL){
+    if(strchr(line, '\n') == NULL && !feof(in)){
+      int c;
+      while((c = getc(in)) != '\n' && c != EOF){}; //line too long
+      line[0] = '\0';
+    }
+    int cube = parse_line(line);
+    char turns[7];
+    int count = get_optimal_turns(depth_table, cube, turns);
+    if(count == -1){
+      fputs("INVALID\n", stdout);
+      continue;
+    }
+    turns[count] = 0;
+    printf("%d%s", get_depth(depth_table, cube), (count > 0) ? " " : "");
+    *format_solution(out, turns) = '\0';
+    fputs(out, stdout);
+  }
+
+  if(in != stdin) fclose(in);
+  if(table != NULL) close_state_table(table);
+  free(made_table);
+  fflush(stdout);
+  return 0;
+}
+
+/** This function writes uniformly random cubes, one per line: the integer
+  * representation of the cube, followed by a shortest scramble that turns
+  * the solved cube into it (F F' L L' U U', see scramble.c). The line can be
+  * given back to solver -b.
+  * @param count The number of cubes
+  * @param depth The number of turns of every scramble, or SCRAMBLE_ANY_DEPTH
+  * @param seed The seed of the random numbers
+  * @return 0 The cubes were written
+  * @return 1 No cube is at that depth, or out of memory
+  */
+int scramble_stream(long count, int depth, uint64_t seed){
+  Scrambler* scrambler = create_scrambler(state_table, seed);
+  if(scrambler == NULL){
+    printf("Could not allocate the scrambler.\n");
+    return 1;
+  }
+
+  static int cubes[STREAM_BATCH];
+  static char scrambles[STREAM_BATCH * SOLUTION_SIZE];
+  static char out[STREAM_BATCH * (OUTPUT_LINE_SIZE + 12)];
+  while(count > 0){
+    size_t n = (count < STREAM_BATCH) ? (size_t) count : STREAM_BATCH;
+    if(scramble_batch(scrambler, depth, cubes, scrambles, n) != n){
+      printf("No cube can be scrambled in %d turns.\n", depth);
+      free_scrambler(scrambler);
+      return 1;
+    }
+
+    char* end = out;
+    size_t i;
+    for(i = 0; i < n; i++){
+      end += sprintf(end, "%d ", cubes[i]);
+      PackedSolution scramble = pack_solution(&scrambles[i * SOLUTION_SIZE]);
+      end = format_packed_solution(end, scramble);
+    }
+    fwrite(out, 1, end - out, stdout);
+    count -= n;
+  }
+  fflush(stdout);
+  free_scrambler(scrambler);
+  return 0;
+}
+
+/** This function solves a stream of cubes, one per line (see solve_stream),
+  * in a variant of the cube (see puzzle.c), and writes the moves of each
+  * solution in its notation (EX: F2). A cube its moves cannot solve gives
+  * the line INVALID. The table of the puzzle is read from <name>_table.bin,
+  * and generated (and saved) when that file does not exist.
+  * @param name The name of the puzzle, or NULL to list the puzzles
+  * @param file_name The file to read, or NULL to read stdin
+  * @return 0 The stream was solved
+  * @return 1 The puzzle is unknown, or its table or the file could not be
+  *    read
+  */
+int puzzle_stream(const char* name, const char* file_name){
+  const Puzzle* puzzle = (name == NULL) ? NULL : find_puzzle(name);
+  if(puzzle == NULL){
+    if(name != NULL) printf("Unknown puzzle %s.\n", name);
+    printf("Puzzles (solver -p puzzle [file]):\n");
+    int i;
+    for(i = 0; puzzle_at(i) != NULL; i++){
+      printf("  %-12s %s\n", puzzle_at(i)->name, puzzle_at(i)->description);
+    }
+    return name != NULL;
+  }
+
+  PuzzleTable* table = load_puzzle_table(puzzle,
+                                         sysconf(_SC_NPROCESSORS_ONLN));
+  if(table == NULL){
+    printf("The %s table could not be generated.\n", puzzle->name);
+    return 1;
+  }
+  FILE* in = (file_name == NULL) ? stdin : fopen(file_name, "r");
+  if(in == NULL){
+    printf("An error occured while reading from %s.\n", file_name);
+    close_puzzle_table(table);
+    return 1;
+  }
+
+  char line[LINE_SIZE];
+  char out[PUZZLE_LINE_SIZE];
+  while(fgets(line, LINE_SIZE, in) != NULL){
+    if(strchr(line, '\n') == NULL && !feof(in)){
+      int c;
+      while((c = getc(in)) != '\n' && c != EOF){}; //line too long
+      line[0] = '\0';
+    }
+    char moves[PUZZLE_SOLUTION_SIZE];
+    int cube = parse_line(line);
+    if(cube == -1 || solve_puzzle_cube_into(table, cube, moves) == -1){
+      moves[0] = -1;
+    }
+    char* end = format_puzzle_solution(out, puzzle, moves);
+    fwrite(out, 1, end - out, stdout);
+  }
+
+  if(in != stdin) fclose(in);
+  fflush(stdout);
+  close_puzzle_table(table);
+  return 0;
+}
+
 /** This function prints an introductory screen with instructions of how
   * to enter the state of the cube.
   */
@@ -136,7 +573,6 @@ int fill_buffer(char* buffer){
   char next_char = getchar();
   char this_char;
   int count = 0;
-  int valid_entry = 1;
   do{
     this_char = next_char;
     if(count < BUFF_SIZE){ //protect from buffer overflow
@@ -176,45 +612,15 @@ int fill_buffer(char* buffer){
   //If it gets here the buffer contains exactly 24 characters, each representing
   //a real color
   
-  //count colors;
-  char color_count[6] = {0,0,0,0,0,0};
-  for(count = 0; count < BUFF_SIZE; count++){
-    switch(buffer[count]){
-      case 'o':
-        color_count[0]++;
-        break;
-      case 'r':
-        color_count[1]++;
-        break;
-      case 'y':
-        color_count[2]++;
-        break;
-      case 'w':
-        color_count[3]++;
-        break;
-      case 'g':
-        color_count[4]++;
-        break;
-      case 'b':
-        color_count[5]++;
-        break;
-    }
-  }
-
-  //check color count
-  for(count = 0; count < 6; count++){
-    if(color_count[count] != 4){
+  switch(check_colors(buffer)){
+    case 1:
       printf("You do not have the right amount of each color.\n");
       return 1;
-    }
-  }
-
-  //check proper orientation (red-yellow-blue in bottom-back-right)
-  if(buffer[15] != 'b' || buffer[18] != 'y' || buffer[23] != 'r'){
-    printf("Your cube is not properly oriented.\n");
-    printf("Remember to put the red-yellow-blue corner in the \
+    case 2:
+      printf("Your cube is not properly oriented.\n");
+      printf("Remember to put the red-yellow-blue corner in the \
             bottom-back-right.\n");
-    return 1;
+      return 1;
   }
   //the cube has all the valid colors, check if it is a real state.
   int cube = compress(buffer);
@@ -222,193 +628,16 @@ int fill_buffer(char* buffer){
     printf("The Cube you entered is not in a possible state.\n");
     return 1;
   }
-  if(cube == -2){
-    printf("A very bad error occured..."); //hopefully it never gets here
-  }
-  return 0;
-
-}
-
-/** This function determines if the cube is in a valid state
-  * @param buffer The buffer containing the cube colors
-  * @param return The integer interpretation of the cube
-  * @param return -1 if the cube is not valid
-  * @param return -2 if the cube appears valid but does not exist in the table
-  */
-int compress (char* buffer){
-  char positions[7][3] = {
-    {buffer[2], buffer[8], buffer[5]}, //Pos0
-    {buffer[20], buffer[10], buffer[7]}, //Pos1
-    {buffer[3], buffer[9], buffer[12]}, //Pos2
-    {buffer[21], buffer[11], buffer[14]}, //Pos3
-    {buffer[0], buffer[17], buffer[4]}, //Pos4
-    {buffer[22], buffer[19], buffer[6]}, //Pos5
-    {buffer[1], buffer[16], buffer[13]} //Pos6
-  };
-
-  char piece_to_pos_map[7]; //array to hold which pieces are in which position
-                            //EX: first element = 3 means piece0 is in pos3
-
-  //determine which piece is in which position
-  int i;
-  for(i = 0; i < 7; i++){
-    char piece = which_piece(positions[i]);
-    switch(piece){
-      case -1: //invalid piece
-        return -1; //indicate invalid cube state
-      default:
-        piece_to_pos_map[piece] = i;
-    }
-
-  }
-  //determine orientation of each cube
-
-  char states[7] = {
-    get_piece_state(0, piece_to_pos_map[0], positions[piece_to_pos_map[0]]),
-    get_piece_state(1, piece_to_pos_map[1], positions[piece_to_pos_map[1]]),
-    get_piece_state(2, piece_to_pos_map[2], positions[piece_to_pos_map[2]]),
-    get_piece_state(3, piece_to_pos_map[3], positions[piece_to_pos_map[3]]),
-    get_piece_state(4, piece_to_pos_map[4], positions[piece_to_pos_map[4]]),
-    get_piece_state(5, piece_to_pos_map[5], positions[piece_to_pos_map[5]]),
-    get_piece_state(6, piece_to_pos_map[6], positions[piece_to_pos_map[6]])
-  };
-
-  //check for invalid states
-  for(i = 0; i < 7; i++){
-    if(states[i] == -1) return -1; //invalid state
-  }
-  
-  int cube = states[0] + (c21_1 * states[1]) + (c21_2 * states[2]) + \
-    (c21_3 * states[3]) + (c21_4 * states[4]) + (c21_5 * states[5]) + \
-    (c21_6 * states[6]);
-
-  //At this point the cube should be valid.
-  //make sure that it is in the table. 
-  
-  if(get_turn(state_table, cube) == -1) return -2;
-  
-  return cube;
-  
-}
-
-
-/** This function determines which piece it has based on the colors
-  * @param piece Character array containing 3 colors
-  * @return The number of the piece
-  * @return -1 If the piece is invalid
-  */
-char which_piece(char* piece){
-  if(contains('o', piece) && contains('w', piece) && contains('g', piece))
-    return 0;
-  else if(contains('r', piece) && contains('w', piece) && contains('g', piece))
+  if(cube == -2){ //every piece is there, but the orientations do not add up
+    printf("A corner of the cube you entered is twisted.\n");
     return 1;
-  else if(contains('o', piece) && contains('w', piece) && contains('b', piece))
-    return 2;
-  else if(contains('r', piece) && contains('w', piece) && contains('b', piece))
-    return 3;
-  else if(contains('o', piece) && contains('y', piece) && contains('g', piece))
-    return 4;
-  else if(contains('r', piece) && contains('y', piece) && contains('g', piece))
-    return 5;
-  else if(contains('o', piece) && contains('y', piece) && contains('b', piece))
-    return 6;
-  else 
-    return -1;
-}
-
-/** This function determins if a character is in a character array of length 3
-  * @param character The char to be found
-  * @param piece the 3 char character array
-  * @return 1 if the char is in the array 
-  * @return 0 if the char is not in the array
-  */
-char contains(char character, char* piece){
-  int i;
-  for(i = 0; i < 3; i++){
-    if(piece[i] == character) return 1;
   }
   return 0;
-}
 
-/** This function determines the state of a piece (position and orientation)
-  * @param piece The piece number (0-6)
-  * @param pos The position number (0-6)
-  * @param piece_orientation Orientation of colors
-  * @return The state of the piece (0-21)
-  * @return -1 the piece is not in a valid state
-  */
-char get_piece_state(char piece, char pos, char* piece_orientation){
-  //see cube.c for an explanation of interpretting orientation
-  char number_orientation[3];
-  int i;
-  for(i = 0; i < 3; i++){
-    switch(piece_orientation[i]){
-      case 'r':
-      case 'o':
-        number_orientation[i] = 0;
-        break;
-      case 'y':
-      case 'w': 
-        number_orientation[i] = 1;
-        break;
-      case 'g':
-      case 'b':
-        number_orientation[i] = 2;
-        break;
-    }
-  }
-  
-  char state;
-  char offset = pos * 3; 
-  if (piece == 0 || piece == 3 || piece == 5 || piece == 6){
-    if (compare_pieces(number_orientation, state_table0356[offset]))
-      state = offset;
-    else if (compare_pieces(number_orientation, state_table0356[offset + 1]))
-      state = offset + 1;
-    else if (compare_pieces(number_orientation, state_table0356[offset + 2]))
-      state = offset + 2;
-    else
-      state = -1; //invalid
-  }else{//pieces 1,2,4,7
-    if (compare_pieces(number_orientation, state_table1247[offset]))
-      state = offset;
-    else if (compare_pieces(number_orientation, state_table1247[offset + 1]))
-      state = offset + 1;
-    else if (compare_pieces(number_orientation, state_table1247[offset + 2]))
-      state = offset + 2;
-    else
-      state = -1; //invalid
-  }
-
-  return state;
 }
 
-/** This function determines if two pieces are the same
-  * @param piece1 
-  * @param piece2
-  * @return 1 if the pieces are the same
-  * @return 0 if the pieces are not the same
+/** This function prints the metrics of the run to stderr (solver -m)
   */
-char compare_pieces(char* piece1, char* piece2){
-  int i;
-  for(i = 0; i < 3; i++){
-    if(piece1[i] != piece2[i]) return 0;
-  }
-  return 1;
+void print_metrics_at_exit(){
+  print_metrics(stderr);
 }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
@@ -0,0 +1,276 @@
+/** File: sorted_index.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the sorted index (see sorted_index.h), built in memory
+  * over a sorted state table when it is asked for (see index_state_table).
+  * The table file is not changed.
+  *
+  * A binary search of the sorted table reads entries megabytes apart at
+  * first, and every step waits for a cache miss before it knows where to read
+  * next. In the index, the cubes a search reads are laid out level by level
+  * instead: the top levels of the tree share a few cache lines that stay in
+  * the cache, and the 16 nodes four levels below any node are next to each
+  * other in one cache line, so a search fetches that line four steps before
+  * it needs it.
+  *
+  * Batches of cubes are solved one turn at a time, like solve_ranked_batch:
+  * the lookups of the whole batch are run together and interleaved, with or
+  * without the index (see get_turn_batch).
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include <string.h>
+#include "sorted_index.h"
+#include "state_table.h"
+#include "cube.h"
+#include "metrics.h"
+
+#define INDEX_GROUP 64 //searches run together by get_indexed_turn_batch
+#define SORTED_GROUP 256 //cubes solved together by solve_sorted_batch
+#define PREFETCH_LEVELS 4 //16 keys, one 64 byte cache line
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+int fill_index(SortedIndex* index, const unsigned char* state_table,
+               int entry, size_t node);
+size_t found_node(size_t node);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~ Sorted Index Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function builds the index of a sorted state table
+  * @param state_table The sorted state table
+  * @return Pointer to the index (20 MB)
+  * @return NULL Out of memory
+  */
+SortedIndex* build_sorted_index(const unsigned char* state_table){
+  SortedIndex* index = (SortedIndex*) malloc(sizeof(SortedIndex));
+  if(index == NULL) return NULL;
+  //aligned, so the 16 keys below a node share one cache line
+  index->keys = (uint32_t*) aligned_alloc(64, (INDEX_NODES + 1) *
+                                              sizeof(uint32_t));
+  index->turns = (char*) malloc(INDEX_NODES + 1);
+  if(index->keys == NULL || index->turns == NULL){
+    free_sorted_index(index);
+    return NULL;
+  }
+  index->keys[0] = UINT32_MAX;
+  index->turns[0] = -1;
+  fill_index(index, state_table, 0, 1);
+  return index;
+}
+
+/** This function frees an index
+  * @param index The index (or NULL)
+  */
+void free_sorted_index(SortedIndex* index){
+  if(index == NULL) return;
+  free(index->keys);
+  free(index->turns);
+  free(index);
+}
+
+/** This function finds the turn for a cube in the index (see get_turn)
+  * @param index The index
+  * @param cube The cube for which to find the turn
+  * @return a number between 1 and 6 representing the turn.
+  * @return -1 cube does not exist
+  */
+char get_indexed_turn(const SortedIndex* index, int cube){
+  if(cube < 0) return -1;
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  METRIC_ADD(METRIC_SORTED_LOOKUPS, 1);
+  METRIC_ADD(METRIC_SORTED_PROBES, INDEX_LEVELS);
+  uint32_t key = (uint32_t) cube;
+  size_t node = 1;
+  int level;
+  for(level = 0; level < INDEX_LEVELS; level++){
+    if(level < INDEX_LEVELS - PREFETCH_LEVELS){
+      __builtin_prefetch(&index->keys[node << PREFETCH_LEVELS]);
+    }
+    node = (2 * node) + (index->keys[node] < key);
+  }
+  node = found_node(node);
+  return (index->keys[node] == key) ? index->turns[node] : -1;
+}
+
+/** This function finds the turns of a batch of cubes in the index. The
+  * searches of the batch are run together one level at a time, and the node
+  * each search reads next is prefetched (see get_turn_batch).
+  * @param index The index
+  * @param cubes The cubes
+  * @param n The number of cubes
+  * @param turns Filled with the turn of each cube (as returned by get_turn)
+  */
+void get_indexed_turn_batch(const SortedIndex* index, const int* cubes,
+                            size_t n, char* turns){
+  METRIC_ADD(METRIC_GET_TURN_CALLS, n);
+  METRIC_ADD(METRIC_SORTED_LOOKUPS, n);
+  METRIC_ADD(METRIC_SORTED_PROBES, n * INDEX_LEVELS);
+  size_t done;
+  for(done = 0; done < n; done += INDEX_GROUP){
+    size_t nodes[INDEX_GROUP];
+    uint32_t keys[INDEX_GROUP];
+    size_t group = (n - done < INDEX_GROUP) ? n - done : INDEX_GROUP;
+    size_t j;
+    for(j = 0; j < group; j++){
+      nodes[j] = 1;
+      //a negative cube can only end at a padding key, and is never found
+      keys[j] = (uint32_t) cubes[done + j];
+    }
+
+    int level;
+    for(level = 0; level < INDEX_LEVELS; level++){
+      for(j = 0; j < group; j++){
+        nodes[j] = (2 * nodes[j]) + (index->keys[nodes[j]] < keys[j]);
+        if(level < INDEX_LEVELS - 1){
+          __builtin_prefetch(&index->keys[nodes[j]]);
+        }
+      }
+    }
+
+    for(j = 0; j < group; j++){
+      size_t node = found_node(nodes[j]);
+      turns[done + j] = (index->keys[node] == keys[j] && cubes[done + j] >= 0)
+                        ? index->turns[node] : -1;
+    }
+  }
+}
+
+/** This funciton solves a cube using the index, into a buffer owned by the
+  * caller (see solve_cube_into).
+  * @param cube The cube to be solved
+  * @param index The index
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_indexed_cube_into(int cube, const SortedIndex* index,
+                            char* turn_sequence){
+  char this_turn;
+  int count = 0;
+  do{
+    this_turn = get_indexed_turn(index, cube);
+    if(this_turn == -1 || this_turn > 0x06 ||
+       (count == SOLUTION_SIZE - 1 && this_turn != 0)){
+      return -1; //signal an invalid cube (or a corrupt table)
+    }
+    turn_sequence[count] = this_turn;
+    if(this_turn != 0) cube = rotate(cube, this_turn - 1);
+    count++;
+  }while(this_turn != 0); //zero signal's final turn
+  return count - 1;
+}
+
+/** This function solves a batch of cubes using a sorted state table. The
+  * cubes are solved together one turn at a time, and the lookups of every
+  * cube that is not solved yet are run together (see get_turn_batch and
+  * get_indexed_turn_batch).
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param state_table The sorted state table
+  * @param index The index of the table, or NULL to search the table itself
+  * @param solutions n * SOLUTION_SIZE chars, filled with the turns for each
+  *    cube (as returned by solve_cube). An invalid cube is given the single
+  *    turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t solve_sorted_batch(const int* cubes, size_t n,
+                          const unsigned char* state_table,
+                          const SortedIndex* index, char* solutions){
+  memset(solutions, 0, n * SOLUTION_SIZE);
+  size_t solved = 0;
+  size_t i;
+  for(i = 0; i < n; i += SORTED_GROUP){
+    int current[SORTED_GROUP]; //each cube, with the turns so far made
+    int lanes[SORTED_GROUP];   //the cubes that are not solved yet
+    char turns[SORTED_GROUP];
+    size_t group = (n - i < SORTED_GROUP) ? n - i : SORTED_GROUP;
+    size_t active = group;
+    size_t j;
+    for(j = 0; j < group; j++){
+      current[j] = cubes[i + j];
+      lanes[j] = (int) j;
+    }
+
+    int turn_index;
+    for(turn_index = 0; turn_index < SOLUTION_SIZE && active > 0;
+        turn_index++){
+      int probes[SORTED_GROUP];
+      for(j = 0; j < active; j++) probes[j] = current[lanes[j]];
+      if(index != NULL){
+        get_indexed_turn_batch(index, probes, active, turns);
+      }else{
+        get_turn_batch(state_table, probes, active, turns);
+      }
+
+      size_t still_active = 0;
+      for(j = 0; j < active; j++){
+        int lane = lanes[j];
+        char* solution = &solutions[(i + lane) * SOLUTION_SIZE];
+        char this_turn = turns[j];
+        if(this_turn == -1 || this_turn > 0x06 ||
+           (turn_index == SOLUTION_SIZE - 1 && this_turn != 0)){
+          memset(solution, 0, SOLUTION_SIZE);
+          solution[0] = -1; //invalid cube (or a corrupt table)
+          continue;
+        }
+        solution[turn_index] = this_turn;
+        if(this_turn == 0){ //zero signal's final turn
+          solved++;
+          continue;
+        }
+        current[lane] = rotate(current[lane], this_turn - 1);
+        lanes[still_active++] = lane;
+      }
+      active = still_active;
+    }
+  }
+  return solved;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function fills the subtree of a node with the entries of the state
+  * table, in order (an in-order walk of the tree visits the nodes in sorted
+  * order). The nodes past the last entry are padding.
+  * @param index The index
+  * @param state_table The sorted state table
+  * @param entry The first entry of the table that is not in the index yet
+  * @param node The node
+  * @return The first entry after the subtree
+  */
+int fill_index(SortedIndex* index, const unsigned char* state_table,
+               int entry, size_t node){
+  if(node > INDEX_NODES) return entry;
+  entry = fill_index(index, state_table, entry, 2 * node);
+  if(entry < NUMBER_OF_CUBES){
+    index->keys[node] = (uint32_t) sorted_cube_at(state_table, entry);
+    index->turns[node] = (char) state_table[(entry * SIZE_OF_CUBE) + 4];
+  }else{
+    index->keys[node] = UINT32_MAX; //padding, after every cube
+    index->turns[node] = -1;
+  }
+  return fill_index(index, state_table, entry + 1, (2 * node) + 1);
+}
+
+/** This function returns the node a search found. A search goes left at
+  * every node whose key is not less than the cube, so the first key that is
+  * not less is the last node it went left at: the search ends below that
+  * node, followed by a 0, then only 1s.
+  * @param node The node below the last level that the search ended at
+  * @return The node of the first key not less than the cube
+  * @return 0 Every key is less than the cube
+  */
+size_t found_node(size_t node){
+  return node >> __builtin_ffsll((long long) ~node);
+}
@@ -0,0 +1,39 @@
+/** File: sorted_index.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the sorted index structure and the function prototypes
+  * for the file sorted_index.c
+  */
+
+#ifndef SORTED_INDEX_H
+#define SORTED_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define INDEX_LEVELS 22 //levels of the index tree (2^22 > 3,674,160)
+#define INDEX_NODES ((1 << INDEX_LEVELS) - 1) //nodes of the full tree
+
+/** The cubes of a sorted state table laid out as a full binary search tree
+  * in breadth first (Eytzinger) order: the children of node i are nodes
+  * 2i and 2i + 1, and node 1 is the root. The tree is padded with
+  * UINT32_MAX keys, so every search takes INDEX_LEVELS steps.
+  */
+typedef struct SortedIndex {
+  uint32_t* keys;     //INDEX_NODES + 1 cubes (keys[0] is never found)
+  char* turns;        //the turn of each cube, at the same node
+} SortedIndex;
+
+//Function Prototypes
+SortedIndex* build_sorted_index(const unsigned char* state_table);
+void free_sorted_index(SortedIndex* index);
+char get_indexed_turn(const SortedIndex* index, int cube);
+void get_indexed_turn_batch(const SortedIndex* index, const int* cubes,
+                            size_t n, char* turns);
+int solve_indexed_cube_into(int cube, const SortedIndex* index,
+                            char* turn_sequence);
+size_t solve_sorted_batch(const int* cubes, size_t n,
+                          const unsigned char* state_table,
+                          const SortedIndex* index, char* solutions);
+
+#endif
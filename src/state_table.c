@@ -13,6 +13,11 @@
   * character. This means 5 * 3,674,160, = 18,370,800 bytes are needed.
   *
   * The states will be stored in sorted order in an array
+  *
+  * The ranked table (ranked_table.bin) is indexed by the rank of a cube
+  * (see rank_cube in cube.c) instead, so the 4 byte state no longer needs to
+  * be stored. Each move fits in 3 bits, and 21 moves are packed into every
+  * 64 bit word. This means 8 * 3,674,160 / 21 = 1,399,680 bytes are needed.
   */
   
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
@@ -21,20 +26,21 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "state_table.h"
 #include "queue.h"
 #include "cube.h"
+#include "table_file.h"
+#include "metrics.h"
 
-#define NUMBER_OF_CUBES 3674160 //number of possible cubes
-#define SIZE_OF_CUBE 5 //5 bytes
-#define SOLVED_CUBE 0x5FD3097E
+#define BATCH_GROUP 64 //cubes solved together by solve_ranked_batch
+#define SEARCH_GROUP 64 //binary searches run together by get_turn_batch
+#define MOVE_BLOCK 64 //cubes the generator turns together
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-int find_index(unsigned char* state_table, int cube);
-void shift_data_up(unsigned char* state_table, int index);
 int get_last_element(unsigned char* state_table);
-int add_state(unsigned char* state_table, int cube, char turn);
+int compare_cubes(const void* cube1, const void* cube2);
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 //~~~~~~~~~~~~~~~~~~~~~~~~~ State_table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
@@ -55,11 +61,11 @@ unsigned char* make_state_table(){
   */
 void write_state_table(unsigned char* state_table){
   FILE* file = fopen("state_table.bin","wb");
-  if(file == NULL) 
+  if(file == NULL){
     printf("An error occured while writing to state_table.bin.\n");
-  else
-    fwrite(state_table, SIZE_OF_CUBE, NUMBER_OF_CUBES, file);
-
+    return;
+  }
+  fwrite(state_table, SIZE_OF_CUBE, NUMBER_OF_CUBES, file);
   fclose(file);
 }
 
@@ -69,74 +75,31 @@ void write_state_table(unsigned char* state_table){
   */
 void read_state_table(unsigned char* state_table){
   FILE* file = fopen("state_table.bin","rb");
-  if(file == NULL) 
+  if(file == NULL){
     printf("An error occured while reading from state_table.bin.\n");
-  else
-    fread(state_table, SIZE_OF_CUBE, NUMBER_OF_CUBES, file);
-
+    return;
+  }
+  fread(state_table, SIZE_OF_CUBE, NUMBER_OF_CUBES, file);
   fclose(file);
 }
 
 /** Fills an empty state_table. 
-  * It begins by performing all possible turns on the solved cube, and storing 
-  * any newly discovered cube states in the state table and in a queue.
-  * It then performs all possible turns on all the states in the queue 
-  * and adds any newly discovered states to both the state_table and the queue.
-  * If a state is rediscovered, it is not added to the queue, and its 'turn'
-  * is not updated in the state_table (we want to keep the first discovered turn 
-  * for each cube to ensure the shortest possible solution path.
+  * The ranked table is generated first (see generate_ranked_table), and is
+  * then written out in the sorted format, so the result is identical to the
+  * table that used to be built with one insertion per discovered state.
   * @param state_table The state tablee to be filled
   * @return 1 The state_table was completely filled
   * @return 0 The state_table was not completely filled
   */
 int fill_state_table(unsigned char* state_table){
-  Queue* queue = createQueue(NUMBER_OF_CUBES);
-  enqueue(queue, SOLVED_CUBE);
-  int count = 0;
-  
-  //while there are still states to be discovered.
-  while(peek(queue) != 0){
-    int this_cube = dequeue(queue);
-    int front_C = frontC(this_cube);
-    int front_CC = frontCC(this_cube);
-    int left_C = leftC(this_cube); 
-    int left_CC = leftCC(this_cube);
-    int top_C = topC(this_cube);
-    int top_CC = topCC(this_cube);
-
-    //add the states to the state_table and if they are new... add them to the 
-    //queue
-    if(add_state(state_table, front_C, 0x01)){
-      enqueue(queue, front_C);
-      count++;
-      printf("%d\n", count);
-    }
-    if(add_state(state_table, front_CC, 0x02)){
-      enqueue(queue, front_CC);
-      count++;
-      printf("%d\n", count);
-    }
-    if(add_state(state_table, left_C, 0x03)){
-      enqueue(queue, left_C);
-      count++;
-      printf("%d\n", count);
-    }
-    if(add_state(state_table, left_CC, 0x04)){
-      enqueue(queue, left_CC);
-      count++;
-      printf("%d\n", count);
-    }
-    if(add_state(state_table, top_C, 0x05)){
-      enqueue(queue, top_C);
-      count++;
-      printf("%d\n", count);
-    }
-    if(add_state(state_table, top_CC, 0x06)){
-      enqueue(queue, top_CC);
-      count++;
-      printf("%d\n", count);
-    }
-  }
+  uint64_t* ranked_table = make_ranked_table();
+  if(ranked_table == NULL) return 0;
+
+  int filled = generate_ranked_table(ranked_table) &&
+               sort_ranked_table(ranked_table, state_table);
+
+  free(ranked_table);
+  return filled;
 }
 
 /** This function comsumes a cube and the finished state table. It returns the 
@@ -144,17 +107,20 @@ int fill_state_table(unsigned char* state_table){
   * @param state_table The finished state_table 
   * @param cube the Cube for which to find the turn.
   * @return a number between 1 and 6 representing the turn.
-  *   1:FC  2:fCC  3:Lc  4:LCC  5:TC  6:TCC
+  *   (see the turn codes in cube.h)
   * @return -1 cube does not exist
   */
-char get_turn(unsigned char* state_table, int cube){
+char get_turn(const unsigned char* state_table, int cube){
   int min = 0;
   int max = NUMBER_OF_CUBES - 1;
   int middle;
   int this_cube;
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  METRIC_ADD(METRIC_SORTED_LOOKUPS, 1);
   //Find the index in the table
   do{
     middle = min + ((max - min) / 2);
+    METRIC_ADD(METRIC_SORTED_PROBES, 1);
 
     unsigned char byte3 = state_table[middle * 5];
     unsigned char byte2 = state_table[(middle * 5) + 1];
@@ -176,156 +142,442 @@ char get_turn(unsigned char* state_table, int cube){
   return -1; //cube not found
 }
 
+/** This function finds the turns of a batch of cubes in the state table
+  * (see get_turn). The binary searches of the batch are run together, one
+  * step at a time, and the entry each search reads next is prefetched: it
+  * is only read after a step of every other search, so the cache misses of
+  * the batch overlap instead of being waited for one after another. Every
+  * search takes the same number of steps, and the steps have no branches.
+  * @param state_table The finished state_table
+  * @param cubes The cubes
+  * @param n The number of cubes
+  * @param turns Filled with the turn of each cube (as returned by get_turn)
+  */
+void get_turn_batch(const unsigned char* state_table, const int* cubes,
+                    size_t n, char* turns){
+  METRIC_ADD(METRIC_GET_TURN_CALLS, n);
+  METRIC_ADD(METRIC_SORTED_LOOKUPS, n);
+  size_t done;
+  for(done = 0; done < n; done += SEARCH_GROUP){
+    int bases[SEARCH_GROUP]; //the last entry known to be <= each cube
+    size_t group = (n - done < SEARCH_GROUP) ? n - done : SEARCH_GROUP;
+    size_t j;
+    for(j = 0; j < group; j++) bases[j] = 0;
+
+    int length = NUMBER_OF_CUBES; //entries left from each base
+    while(length > 1){
+      int half = length / 2;
+      int next = (length - half) / 2; //how far the next step reads
+      for(j = 0; j < group; j++){
+        int middle = bases[j] + half;
+        if(sorted_cube_at(state_table, middle) <= cubes[done + j]){
+          bases[j] = middle;
+        }
+        __builtin_prefetch(&state_table[(bases[j] + next) * SIZE_OF_CUBE]);
+      }
+      METRIC_ADD(METRIC_SORTED_PROBES, group);
+      length -= half;
+    }
+
+    for(j = 0; j < group; j++){
+      turns[done + j] = (sorted_cube_at(state_table, bases[j]) ==
+                         cubes[done + j])
+                        ? state_table[(bases[j] * SIZE_OF_CUBE) + 4] : -1;
+    }
+  }
+}
+
+/** This function reads the cube of an entry of the state table
+  * @param state_table The finished state_table
+  * @param index The entry (0 - 3,674,159)
+  * @return The integer representation of the cube
+  */
+int sorted_cube_at(const unsigned char* state_table, int index){
+  const unsigned char* entry = &state_table[index * SIZE_OF_CUBE];
+  return (((int) entry[0]) << 24) | (((int) entry[1]) << 16) |
+         (((int) entry[2]) << 8) | ((int) entry[3]);
+}
+
 /** This funciton solves a cube. It returns a character array representing the 
   * turns used to solve a cube. It returns null if an invalid cube is passed in
   * as a parameter.
   * @param cube The cube to be solved
   * @param state_table The state_table
   * @return A character array representing the turns needed to solve the cube. 
-  *    1:FC  2:fCC  3:Lc  4:LCC  5:TC  6:TCC
+  *    (see the turn codes in cube.h)
   * @return NULL signal an error (invalid cube)
   */
-char* solve_cube(int cube, char* state_table){
+char* solve_cube(int cube, const unsigned char* state_table){
+  char* turn_sequence = malloc(SOLUTION_SIZE);
+  if(turn_sequence == NULL) return NULL;
+  if(solve_cube_into(cube, state_table, turn_sequence) == -1){
+    free(turn_sequence);
+    return NULL; //signal an invalid cube.
+  }
+  return turn_sequence;
+}
+
+/** This funciton solves a cube into a buffer owned by the caller.
+  * @param cube The cube to be solved
+  * @param state_table The state_table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_cube_into(int cube, const unsigned char* state_table,
+                    char* turn_sequence){
   char this_turn;
-  char* turn_sequence = calloc(1,15); //all cubes can be solved in 14 moves or
-                                      //or less. The last spot holds the 
-                                      //terminator (0)
   int count = 0;
   do{
     this_turn = get_turn(state_table, cube);
-    if(this_turn == -1){
-      return NULL; //signal an invalid cube.
-      break;
+    if(this_turn == -1 || this_turn > 0x06 || 
+       (count == SOLUTION_SIZE - 1 && this_turn != 0)){
+      return -1; //signal an invalid cube (or a corrupt table)
     }
-    else{
-      turn_sequence[count] = this_turn; //store the turn 
-
-      //perform the turn 
-      switch(this_turn){
-      case 0:
-        break;
-      case 1:
-	cube = frontCC(cube);
-        break;
-      case 2:
-        cube = frontC(cube);
-        break;
-      case 3:
-        cube = leftCC(cube);
-        break;
-      case 4:
-        cube = leftC(cube);
-        break;
-      case 5:
-        cube = topCC(cube);
-        break;
-      case 6:
-        cube = topC(cube);
-        break;
-      }
-      count++;
+    turn_sequence[count] = this_turn; //store the turn 
+
+    //perform the turn 
+    switch(this_turn){
+    case 0:
+      break;
+    case 1:
+      cube = frontCC(cube);
+      break;
+    case 2:
+      cube = frontC(cube);
+      break;
+    case 3:
+      cube = leftCC(cube);
+      break;
+    case 4:
+      cube = leftC(cube);
+      break;
+    case 5:
+      cube = topCC(cube);
+      break;
+    case 6:
+      cube = topC(cube);
+      break;
     }
+    count++;
   }while(this_turn != 0); //zero signal's final turn
-  return turn_sequence;
+  return count - 1;
 }
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-
-/** This function adds a cube and the turn used to get to that state
-  * into the state table. If the cube already exists in the table it will not
-  * be added. The cubes are added such that they are in ascending order. 
-  * @param cube the cube to be added to the table 
-  * @param turn the Turn used to reach the state
-  * @return 0 When the cube was already in the table
-  * @return 1 When the cube was successfully added
+/** This function creates an array of 64 bit words to store the ranked table.
+  * @return A pointer to the array of words
   */
-int add_state(unsigned char* state_table, int cube, char turn){
-  int cube_index; //indexed by cube_state (5 bytes)
-  cube_index = find_index(state_table, cube);
-  if (cube_index == -1) return 0; //the cube already existed in the table
-  shift_data_up(state_table, cube_index);
-  
-  //break down the cube int into four chars
-  unsigned char byte0 = (unsigned char) cube;
-  unsigned char byte1 = (unsigned char) (cube >> 8);
-  unsigned char byte2 = (unsigned char) (cube >> 16);
-  unsigned char byte3 = (unsigned char) (cube >> 24);
-
-  int insert_index = cube_index * 5; //indexed by bytes
-
-  //insert data into state_table (integer stored in big endian format)
-  //integer stored before char
-  state_table[insert_index] = byte3;
-  state_table[insert_index + 1] = byte2;
-  state_table[insert_index + 2] = byte1;
-  state_table[insert_index + 3] = byte0;
-  state_table[insert_index + 4] = turn;
-  return 1;
+uint64_t* make_ranked_table(){
+  uint64_t* ranked_table = (uint64_t*) calloc(RANKED_TABLE_WORDS,
+                                              sizeof(uint64_t));
+  return ranked_table;
 }
 
-/** This function determines the index in which a cube shouuld be inserted
-  * If the cube already exists in the table the function returns -1
-  * @param state_table The table in-which to insert the cube
-  * @param cube The cube to be inserted
-  * @return The index that the cube should be inserted at
-  * @return -1 if no insertion needs to take place.
+/** This function writes a ranked table, with a table header, to the binary 
+  * file ranked_table.bin (see table_file.c)
+  * @param ranked_table The table to write to memory
   */
-int find_index(unsigned char* state_table, int cube){
-  //break cube up into bytes
-  unsigned char byte0 = (unsigned char) cube;
-  unsigned char byte1 = (unsigned char) (cube >> 8);
-  unsigned char byte2 = (unsigned char) (cube >> 16);
-  unsigned char byte3 = (unsigned char) (cube >> 24);
+void write_ranked_table(const uint64_t* ranked_table){
+  if(!save_state_table("ranked_table.bin", TABLE_RANKED, ranked_table,
+                       RANKED_TABLE_WORDS * sizeof(uint64_t)))
+    printf("An error occured while writing to ranked_table.bin.\n");
+}
 
+/** This function converts a sorted state table into a ranked table.
+  * @param state_table The finished (sorted) state_table
+  * @param ranked_table The ranked table to be filled
+  * @return 1 Every cube was ranked
+  * @return 0 The state_table contains a cube that is not reachable
+  */
+int rank_state_table(const unsigned char* state_table, uint64_t* ranked_table){
   int i;
   for(i = 0; i < NUMBER_OF_CUBES; i++){
-    int byte_index = i * 5;
-    
-    if (state_table[byte_index] == 0x00 &&
-        state_table[byte_index + 1] == 0x00 &&
-        state_table[byte_index + 2] == 0x00 &&
-        state_table[byte_index + 3] == 0x00){
-      return i;//if the new cube is bigger than all previous cubes, the index
-               //should be the 'empty space' to the right of the biggest element
+    unsigned char byte3 = state_table[i * 5];
+    unsigned char byte2 = state_table[(i * 5) + 1];
+    unsigned char byte1 = state_table[(i * 5) + 2];
+    unsigned char byte0 = state_table[(i * 5) + 3];
+
+    int this_cube = (((int) byte3) << 24) | (((int) byte2) << 16) | 
+                     (((int) byte1) << 8) | ((int) byte0);
+
+    int rank = rank_cube(this_cube);
+    if(rank == -1) return 0;
+    set_ranked_turn(ranked_table, rank, state_table[(i * 5) + 4]);
+  }
+  return 1;
+}
+
+/** This function comsumes a cube and the finished ranked table. It returns the
+  * turn used to get to that cube state with a single table load.
+  * @param ranked_table The finished ranked table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn.
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist
+  */
+char get_ranked_turn(const uint64_t* ranked_table, int cube){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1; //cube not reachable
+
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  return ranked_turn_at(ranked_table, rank);
+}
+
+/** This funciton solves a cube using the ranked table. It returns a character
+  * array representing the turns used to solve a cube. It returns null if an 
+  * invalid cube is passed in as a parameter.
+  * @param cube The cube to be solved
+  * @param ranked_table The ranked table
+  * @return A character array representing the turns needed to solve the cube. 
+  *    (see the turn codes in cube.h)
+  * @return NULL signal an error (invalid cube)
+  */
+char* solve_ranked_cube(int cube, const uint64_t* ranked_table){
+  char* turn_sequence = malloc(SOLUTION_SIZE);
+  if(turn_sequence == NULL) return NULL;
+  if(solve_ranked_cube_into(cube, ranked_table, turn_sequence) == -1){
+    free(turn_sequence);
+    return NULL; //signal an invalid cube.
+  }
+  return turn_sequence;
+}
+
+/** This funciton solves a cube using the ranked table, into a buffer owned by
+  * the caller.
+  * @param cube The cube to be solved
+  * @param ranked_table The ranked table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_ranked_cube_into(int cube, const uint64_t* ranked_table, 
+                           char* turn_sequence){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1; //signal an invalid cube
+
+  char this_turn;
+  int perm = rank / NUMBER_OF_ORIENTATIONS;
+  int orient = rank % NUMBER_OF_ORIENTATIONS;
+  int count = 0;
+  do{
+    this_turn = ranked_turn_at(ranked_table, 
+                               (perm * NUMBER_OF_ORIENTATIONS) + orient);
+    if(this_turn > 0x06 || (count == SOLUTION_SIZE - 1 && this_turn != 0)){
+      return -1; //signal a corrupt table
+    }
+    turn_sequence[count] = this_turn; //store the turn
+
+    //undo the turn: turn n is undone by rotation n - 1 (see cube.c)
+    if(this_turn != 0){
+      perm = perm_move_table[perm][this_turn - 1];
+      orient = orient_move_table[orient][this_turn - 1];
+    }
+    count++;
+  }while(this_turn != 0); //zero signal's final turn
+  METRIC_ADD(METRIC_GET_TURN_CALLS, count);
+  return count - 1;
+}
+
+/** This function solves a batch of cubes using the ranked table. The cubes 
+  * are solved together one turn at a time, so the table loads for the whole 
+  * batch are independent of each other and their cache misses overlap.
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param ranked_table The ranked table
+  * @param solutions n * SOLUTION_SIZE chars, filled with the turns for each 
+  *    cube (as returned by solve_cube). An invalid cube is given the single
+  *    turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t solve_ranked_batch(const int* cubes, size_t n, 
+                          const uint64_t* ranked_table, char* solutions){
+  memset(solutions, 0, n * SOLUTION_SIZE);
+
+  size_t i;
+  size_t solved = 0;
+  for(i = 0; i < n; i += BATCH_GROUP){
+    int ranks[BATCH_GROUP];
+    char rotations[BATCH_GROUP]; //the rotation that undoes each turn
+    char finished[BATCH_GROUP];
+    size_t group = (n - i < BATCH_GROUP) ? n - i : BATCH_GROUP;
+
+    //rank the whole group first
+    size_t j;
+    for(j = 0; j < group; j++){
+      ranks[j] = rank_cube(cubes[i + j]);
+      rotations[j] = 0;
+      finished[j] = (ranks[j] == -1);
+      if(finished[j]){
+        solutions[(i + j) * SOLUTION_SIZE] = -1;
+        ranks[j] = 0; //keeps the lane a valid rank for rotate_rank_each
+      }
     }
-    if (state_table[byte_index] < byte3) continue;
-    else if(state_table[byte_index] > byte3) return i;
-    else { //bytes are equal
-      if (state_table[byte_index + 1] < byte2) continue;
-      else if(state_table[byte_index + 1] > byte2) return i;
-      else { //bytes are equal
-        if (state_table[byte_index + 2] < byte1) continue;
-        else if(state_table[byte_index + 2] > byte1) return i;
-        else { //bytes are equal
-          if (state_table[byte_index + 3] < byte0) continue;
-          else if(state_table[byte_index + 3] > byte0) return i;
-          else { //bytes are equal
-            return -1; // the cube is already in the table
-          }
-        }    
+
+    int turn_index;
+    for(turn_index = 0; turn_index < SOLUTION_SIZE; turn_index++){
+      int active = 0;
+      for(j = 0; j < group; j++){
+        if(finished[j]) continue;
+        char* solution = &solutions[(i + j) * SOLUTION_SIZE];
+        char this_turn = ranked_turn_at(ranked_table, ranks[j]);
+        METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+        if(this_turn > 0x06 || (turn_index == 14 && this_turn != 0)){
+          memset(solution, 0, SOLUTION_SIZE);
+          solution[0] = -1; //corrupt table
+          finished[j] = 1;
+          rotations[j] = 0;
+          continue;
+        }
+        solution[turn_index] = this_turn;
+        if(this_turn == 0){ //zero signal's final turn
+          finished[j] = 1;
+          rotations[j] = 0;
+          solved++;
+          continue;
+        }
+        rotations[j] = this_turn - 1; //turn n is undone by rotation n - 1
+        active = 1;
       }
+      if(!active) break;
+      rotate_rank_each(ranks, rotations, group); //undo the turns together
     }
   }
+  return solved;
 }
 
-/** This function shifts the contents of a state table by 5 bytes. It only 
-  * shifts the data at or after the provided index.
-  * @param state_table The table to be shifted
-  * @param index The index at which to begin shifting 
-  *  (where an int and turn are 1 element)
+/** Fills an empty ranked table with a breadth first search from the solved
+  * cube. The table itself records which cubes have been visited (a turn of 
+  * UNVISITED), so every discovered state costs one table load and one store.
+  * As before, only the first discovered turn is kept for each cube to ensure
+  * the shortest possible solution path.
+  * @param ranked_table The ranked table to be filled
+  * @return 1 The table was completely filled
+  * @return 0 The table was not completely filled
   */
-void shift_data_up(unsigned char* state_table, int index){
-  int i;
-  for(i = NUMBER_OF_CUBES - 2; i >= index; i--){ //for all cube_states except
-    int this_index = i * 5;                       //the last
-    int j;
-    for(j = 0; j < 5; j++){ //shift up 1 cube_state
-      state_table[this_index+5] = state_table[this_index];
-      this_index++;
+int generate_ranked_table(uint64_t* ranked_table){
+  Queue64* queue = createQueue64(0);
+  if(queue == NULL) return 0;
+
+  memset(ranked_table, 0xFF, RANKED_TABLE_WORDS * sizeof(uint64_t));
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  set_ranked_turn(ranked_table, solved_rank, 0x00);
+  enqueue64(queue, solved_rank);
+  int count = 1;
+  int filled = 1;
+  METRIC_BFS_BEGIN();
+
+  //while there are still states to be discovered.
+  while(queue->cells_used > 0 && filled){
+    //turn a block of cubes at once, then visit them in queue order
+    uint64_t entries[MOVE_BLOCK];
+    int block[MOVE_BLOCK];
+    int turned[6][MOVE_BLOCK];
+    uint64_t found[MOVE_BLOCK * 6];
+    size_t found_size = 0;
+    int size = (int) dequeue64_n(queue, entries, MOVE_BLOCK);
+    int i;
+    for(i = 0; i < size; i++) block[i] = (int) entries[i];
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      memcpy(turned[rotation], block, size * sizeof(int));
+      rotate_rank_batch(turned[rotation], size, rotation);
     }
+
+    for(i = 0; i < size; i++){
+      //turn n is reached by rotation (n - 1) ^ 1 (FC, FCC, LC, LCC, TC, TCC)
+      char turn;
+      for(turn = 0x01; turn <= 0x06; turn++){
+        int rank = turned[(turn - 1) ^ 1][i];
+        if(ranked_turn_at(ranked_table, rank) == UNVISITED){
+          set_ranked_turn(ranked_table, rank, turn);
+          found[found_size++] = rank;
+          count++;
+        }
+      }
+      METRIC_BFS_VISIT(count);
+    }
+    filled = (enqueue64_n(queue, found, found_size) == QUEUE_OK);
+  }
+  deleteQueue64(queue);
+
+  //clear the unused top bit of every word
+  int i;
+  for(i = 0; i < RANKED_TABLE_WORDS; i++){
+    ranked_table[i] &= ~(((uint64_t) 1) << 63);
+  }
+  return filled && count == NUMBER_OF_CUBES;
+}
+
+/** This function converts a ranked table into the sorted state table format
+  * so that existing readers of state_table.bin keep working.
+  * @param ranked_table The finished ranked table
+  * @param state_table The state_table to be filled
+  * @return 1 The state_table was filled
+  * @return 0 Out of memory
+  */
+int sort_ranked_table(const uint64_t* ranked_table, unsigned char* state_table){
+  int* cubes = (int*) malloc(NUMBER_OF_CUBES * sizeof(int));
+  if(cubes == NULL) return 0;
+
+  int i;
+  for(i = 0; i < NUMBER_OF_CUBES; i++){
+    cubes[i] = unrank_cube(i);
+  }
+  qsort(cubes, NUMBER_OF_CUBES, sizeof(int), compare_cubes);
+
+  for(i = 0; i < NUMBER_OF_CUBES; i++){
+    int cube = cubes[i];
+    //integer stored in big endian format, before the turn
+    state_table[i * 5] = (unsigned char) (cube >> 24);
+    state_table[(i * 5) + 1] = (unsigned char) (cube >> 16);
+    state_table[(i * 5) + 2] = (unsigned char) (cube >> 8);
+    state_table[(i * 5) + 3] = (unsigned char) cube;
+    state_table[(i * 5) + 4] = get_ranked_turn(ranked_table, cube);
   }
+
+  free(cubes);
+  return 1;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function stores the turn used to reach a cube in the ranked table
+  * @param ranked_table The ranked table
+  * @param rank The rank of the cube
+  * @param turn the Turn used to reach the state
+  */
+void set_ranked_turn(uint64_t* ranked_table, int rank, char turn){
+  int shift = (rank % TURNS_PER_WORD) * 3;
+  uint64_t* word = &ranked_table[rank / TURNS_PER_WORD];
+  *word = (*word & ~(((uint64_t) 0x07) << shift)) | 
+          (((uint64_t) turn) << shift);
+}
+
+/** This function reads the turn stored for a rank in the ranked table
+  * @param ranked_table The ranked table
+  * @param rank The rank of the cube
+  * @return The 3 bit turn stored for the rank
+  */
+char ranked_turn_at(const uint64_t* ranked_table, int rank){
+  uint64_t word = ranked_table[rank / TURNS_PER_WORD];
+  return (char) ((word >> ((rank % TURNS_PER_WORD) * 3)) & 0x07);
+}
+
+/** This function compares two cubes for qsort
+  * @param cube1 Pointer to the first cube
+  * @param cube2 Pointer to the second cube
+  * @return negative, zero or positive when cube1 is less, equal or greater
+  */
+int compare_cubes(const void* cube1, const void* cube2){
+  int a = *((const int*) cube1);
+  int b = *((const int*) cube2);
+  return (a > b) - (a < b);
 }
 
 /** This function returns the last element of the state_table as an int
@@ -365,7 +617,8 @@ void test_state_table(){
     int this_cube = (((int) byte3) << 24) | (((int) byte2) << 16) | 
                      (((int) byte1) << 8) | ((int) byte0);
 
-    if(solve_cube(this_cube, state_table) == NULL){
+    char turn_sequence[SOLUTION_SIZE];
+    if(solve_cube_into(this_cube, state_table, turn_sequence) == -1){
       printf("INVALID %d\n", this_cube);
     }
   }
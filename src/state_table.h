@@ -7,13 +7,43 @@
 #ifndef STATE_TABLE_H
 #define STATE_TABLE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#define NUMBER_OF_CUBES 3674160 //number of possible cubes
+#define SIZE_OF_CUBE 5 //5 bytes
+#define SOLVED_CUBE 0x5FD3097E
+#define TURNS_PER_WORD 21 //3 bit turns packed into a 64 bit word
+#define RANKED_TABLE_WORDS (NUMBER_OF_CUBES / TURNS_PER_WORD)
+#define SOLUTION_SIZE 15 //14 turns or less, and the terminator (0)
+#define UNVISITED 0x07 //turn code of a cube the generator has not reached
+
 //Function Prototypes
 unsigned char* make_state_table();
 void write_state_table(unsigned char* state_table);
 void read_state_table(unsigned char* state_table);
 int fill_state_table(unsigned char* state_table);
-char get_turn(unsigned char* state_table, int cube);
-char* solve_cube(int cube, char* state_table);
+char get_turn(const unsigned char* state_table, int cube);
+void get_turn_batch(const unsigned char* state_table, const int* cubes,
+                    size_t n, char* turns);
+int sorted_cube_at(const unsigned char* state_table, int index);
+char* solve_cube(int cube, const unsigned char* state_table);
+int solve_cube_into(int cube, const unsigned char* state_table,
+                    char* turn_sequence);
+
+uint64_t* make_ranked_table();
+void write_ranked_table(const uint64_t* ranked_table);
+int rank_state_table(const unsigned char* state_table, uint64_t* ranked_table);
+int generate_ranked_table(uint64_t* ranked_table);
+int sort_ranked_table(const uint64_t* ranked_table, unsigned char* state_table);
+char get_ranked_turn(const uint64_t* ranked_table, int cube);
+char ranked_turn_at(const uint64_t* ranked_table, int rank);
+void set_ranked_turn(uint64_t* ranked_table, int rank, char turn);
+char* solve_ranked_cube(int cube, const uint64_t* ranked_table);
+int solve_ranked_cube_into(int cube, const uint64_t* ranked_table, 
+                           char* turn_sequence);
+size_t solve_ranked_batch(const int* cubes, size_t n, 
+                          const uint64_t* ranked_table, char* solutions);
 
 void test_state_table();
 #endif
@@ -0,0 +1,352 @@
+/** File: symmetry_table.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the functions used to store a symmetry reduced ranked
+  * table in the file:
+  *   symmetry_table.bin
+  *
+  * Piece 7 never moves, so the only symmetries of the cube that can be used
+  * are the ones that keep the bottom_back_right corner in place: the two
+  * rotations about the diagonal through that corner (which cycle the top,
+  * front and left faces) and the three mirrors through planes containing it
+  * (which swap two of the faces). With the identity these are 6 symmetries,
+  * each of which swaps the axes of the cube (see axis_order). The faces that
+  * are turned (top, front and left) are swapped among themselves, so a
+  * symmetry maps each turn to another turn (a mirror also reverses it).
+  *
+  * A symmetry applied to a cube (S * cube * S^-1) gives a cube that needs the
+  * same number of turns, and the turns that solve it are the symmetric turns.
+  * So only one permutation out of each set of symmetric permutations (a
+  * class) is stored, with all 729 orientations: 870 * 729 turns of 3 bits
+  * in 236KB, instead of 1.4MB for the ranked table.
+  *
+  * To find the turn for a cube, the cube is moved by the symmetry that takes
+  * its permutation to the stored one, the turn is read, and the turn is moved
+  * back by the inverse symmetry.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "symmetry_table.h"
+#include "state_table.h"
+#include "table_file.h"
+#include "cube.h"
+#include "metrics.h"
+
+#define TB 0 //top-bottom axis
+#define FB 1 //front-back axis
+#define RL 2 //right-left axis
+
+extern char state_table0356[21][3];
+extern char state_table1247[21][3];
+
+//powers of 21 indexed by piece
+static int c21[7] = {1, 21, 441, 9261, 194481, 4084101, 85766121};
+
+/** axis_order[s][axis] is the axis that symmetry s moves an axis to.
+  * The first is the identity, then the two rotations, then the three mirrors
+  */
+static int axis_order[NUMBER_OF_SYMMETRIES][3] = {
+  {TB, FB, RL}, {FB, RL, TB}, {RL, TB, FB},
+  {TB, RL, FB}, {RL, FB, TB}, {FB, TB, RL}};
+
+/** The following tables are filled by init_symmetries
+  * symmetry_value[s][p][x]: what piece p in state x adds to the moved cube
+  * symmetry_turn[s][t]: the turn t (0 - 6) after symmetry s
+  * inverse_symmetry[s]: the symmetry that undoes symmetry s
+  * canonical_symmetry[p]: the symmetry that moves p to its class' permutation
+  * perm_class[p]: the class of permutation p, if p is the stored one (or -1)
+  */
+static int symmetry_value[NUMBER_OF_SYMMETRIES][7][21];
+static char symmetry_turn[NUMBER_OF_SYMMETRIES][7];
+static int inverse_symmetry[NUMBER_OF_SYMMETRIES];
+static char canonical_symmetry[NUMBER_OF_PERMUTATIONS];
+static short perm_class[NUMBER_OF_PERMUTATIONS];
+static pthread_once_t symmetries_once = PTHREAD_ONCE_INIT;
+static atomic_int symmetries_ready = 0; //1 once the tables are filled
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void fill_symmetries();
+int move_position(int pos, int symmetry);
+int move_state(int piece, int state, int symmetry);
+char* colors_of(int piece, int state);
+int symmetry_index(int cube, int* symmetry);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Symmetry Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function fills the symmetry tables. The tables are filled by the
+  * first call only (see fill_symmetries), and every other thread calling in
+  * waits for them, so it is safe to call before every use from any thread.
+  * @return 1 The tables are ready
+  * @return 0 The symmetries do not match the cube (should never happen)
+  */
+int init_symmetries(){
+  pthread_once(&symmetries_once, fill_symmetries);
+  return atomic_load_explicit(&symmetries_ready, memory_order_acquire);
+}
+
+/** This function applies a symmetry to a cube (S * cube * S^-1)
+  * @param cube The cube
+  * @param symmetry The symmetry (0 - 5)
+  * @return The symmetric cube
+  */
+int conjugate_cube(int cube, int symmetry){
+  int moved = 0;
+  int piece;
+  for(piece = 0; piece < 7; piece++){
+    moved += symmetry_value[symmetry][piece][cube % 21];
+    cube /= 21;
+  }
+  return moved;
+}
+
+/** This function applies a symmetry to a turn, so that the symmetric turn on
+  * the symmetric cube gives the symmetric cube of the turned cube.
+  * @param turn The turn (0 - 6, as returned by get_turn)
+  * @param symmetry The symmetry (0 - 5)
+  * @return The symmetric turn
+  */
+int conjugate_turn(char turn, int symmetry){
+  return symmetry_turn[symmetry][(int) turn];
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~ Symmetry_table Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function creates an array of 64 bit words to store the symmetry
+  * table.
+  * @return A pointer to the array of words
+  */
+uint64_t* make_symmetry_table(){
+  uint64_t* symmetry_table =
+    (uint64_t*) calloc(SYMMETRY_TABLE_WORDS, sizeof(uint64_t));
+  return symmetry_table;
+}
+
+/** This function fills the symmetry table from a finished ranked table, by
+  * keeping the turns of the cubes whose permutation is stored.
+  * @param ranked_table The finished ranked table
+  * @param symmetry_table The symmetry table to be filled
+  * @return 1 The table was filled
+  * @return 0 The symmetries could not be initialized
+  */
+int reduce_ranked_table(const uint64_t* ranked_table, uint64_t* symmetry_table){
+  if(!init_symmetries()) return 0;
+  int perm, orient;
+  for(perm = 0; perm < NUMBER_OF_PERMUTATIONS; perm++){
+    if(perm_class[perm] == -1) continue;
+    int rank = perm * NUMBER_OF_ORIENTATIONS;
+    int index = perm_class[perm] * NUMBER_OF_ORIENTATIONS;
+    for(orient = 0; orient < NUMBER_OF_ORIENTATIONS; orient++){
+      set_ranked_turn(symmetry_table, index + orient,
+                      ranked_turn_at(ranked_table, rank + orient));
+    }
+  }
+  return 1;
+}
+
+/** This function writes a symmetry table, with a table header, to the binary
+  * file symmetry_table.bin (see table_file.c)
+  * @param symmetry_table The table to write to memory
+  */
+void write_symmetry_table(const uint64_t* symmetry_table){
+  if(!save_state_table("symmetry_table.bin", TABLE_SYMMETRY, symmetry_table,
+                       SYMMETRY_TABLE_WORDS * sizeof(uint64_t)))
+    printf("An error occured while writing to symmetry_table.bin.\n");
+}
+
+/** This function returns the turn used to get to a cube, using the symmetry
+  * table.
+  * @param symmetry_table The finished symmetry table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn.
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist
+  */
+char get_symmetry_turn(const uint64_t* symmetry_table, int cube){
+  if(!init_symmetries()) return -1;
+  int symmetry;
+  int index = symmetry_index(cube, &symmetry);
+  if(index == -1) return -1; //cube not reachable
+
+  char turn = ranked_turn_at(symmetry_table, index);
+  METRIC_ADD(METRIC_GET_TURN_CALLS, 1);
+  if(turn > 0x06) return -1; //corrupt table
+  return conjugate_turn(turn, inverse_symmetry[symmetry]);
+}
+
+/** This funciton solves a cube using the symmetry table, into a buffer owned
+  * by the caller.
+  * @param cube The cube to be solved
+  * @param symmetry_table The symmetry table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  *    (see the turn codes in cube.h)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int solve_symmetry_cube_into(int cube, const uint64_t* symmetry_table,
+                             char* turn_sequence){
+  char this_turn;
+  int count = 0;
+  do{
+    this_turn = get_symmetry_turn(symmetry_table, cube);
+    if(this_turn == -1 || (count == SOLUTION_SIZE - 1 && this_turn != 0)){
+      return -1; //signal an invalid cube or a corrupt table
+    }
+    turn_sequence[count] = this_turn; //store the turn
+
+    //undo the turn: turn n is undone by rotation n - 1 (see cube.c)
+    if(this_turn != 0) cube = rotate(cube, this_turn - 1);
+    count++;
+  }while(this_turn != 0); //zero signal's final turn
+  return count - 1;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function fills the symmetry tables (see init_symmetries), and sets
+  * symmetries_ready when they match the cube
+  */
+void fill_symmetries(){
+  int s, piece, state;
+  for(s = 0; s < NUMBER_OF_SYMMETRIES; s++){
+    for(piece = 0; piece < 7; piece++){
+      for(state = 0; state < 21; state++){
+        int moved = move_state(piece, state, s);
+        if(moved == -1) return;
+        symmetry_value[s][piece][state] =
+          (moved % 21) * c21[move_position(piece, s)];
+      }
+    }
+  }
+
+  //find the inverse of each symmetry, and where each turn goes
+  int test_cube = rotate(rotate(rotate(SOLVED_CUBE, 0), 3), 5);
+  for(s = 0; s < NUMBER_OF_SYMMETRIES; s++){
+    int t;
+    for(t = 0; t < NUMBER_OF_SYMMETRIES; t++){
+      if(conjugate_cube(conjugate_cube(test_cube, s), t) == test_cube)
+        inverse_symmetry[s] = t;
+    }
+    symmetry_turn[s][0] = 0;
+    int rotation;
+    for(rotation = 0; rotation < 6; rotation++){
+      int moved = conjugate_cube(rotate(test_cube, rotation), s);
+      symmetry_turn[s][rotation + 1] = 0;
+      int r;
+      for(r = 0; r < 6; r++){
+        if(rotate(conjugate_cube(test_cube, s), r) == moved)
+          symmetry_turn[s][rotation + 1] = r + 1;
+      }
+      if(symmetry_turn[s][rotation + 1] == 0) return;
+    }
+  }
+
+  //pick the smallest permutation of each class as the one stored
+  int perm;
+  int classes = 0;
+  for(perm = 0; perm < NUMBER_OF_PERMUTATIONS; perm++){
+    int cube = unrank_cube(perm * NUMBER_OF_ORIENTATIONS);
+    int smallest = perm;
+    canonical_symmetry[perm] = 0;
+    for(s = 1; s < NUMBER_OF_SYMMETRIES; s++){
+      int moved = rank_cube(conjugate_cube(cube, s)) / NUMBER_OF_ORIENTATIONS;
+      if(moved < smallest){
+        smallest = moved;
+        canonical_symmetry[perm] = s;
+      }
+    }
+    perm_class[perm] = (canonical_symmetry[perm] == 0) ? classes++ : -1;
+  }
+  if(classes != PERMUTATION_CLASSES) return;
+
+  atomic_store_explicit(&symmetries_ready, 1, memory_order_release);
+}
+
+/** This function finds where a symmetry moves a position (or the piece that
+  * belongs there). A position is labeled by its sides (see cube.c):
+  * bit 0 is set on the bottom, bit 1 on the right and bit 2 on the back.
+  * @param pos The position (0 - 7)
+  * @param symmetry The symmetry
+  * @return The moved position
+  */
+int move_position(int pos, int symmetry){
+  static const int axis_bit[3] = {1, 4, 2}; //TB, FB, RL
+  int moved = 0;
+  int axis;
+  for(axis = 0; axis < 3; axis++){
+    if(pos & axis_bit[axis]) moved |= axis_bit[axis_order[symmetry][axis]];
+  }
+  return moved;
+}
+
+/** This function finds the state of a piece after a symmetry. The color that
+  * faces an axis is moved to face the symmetric axis, and it becomes the
+  * color of the symmetric piece for the symmetric axis.
+  * @param piece The piece (0 - 6)
+  * @param state The state of the piece (0 - 20)
+  * @param symmetry The symmetry
+  * @return The state of the symmetric piece
+  * @return -1 There is no such state
+  */
+int move_state(int piece, int state, int symmetry){
+  int moved_piece = move_position(piece, symmetry);
+  int moved_pos = move_position(state / 3, symmetry);
+  char* colors = colors_of(piece, state);
+  char moved_colors[3];
+  int axis;
+  for(axis = 0; axis < 3; axis++){
+    moved_colors[axis_order[symmetry][axis]] =
+      axis_order[symmetry][(int) colors[axis]];
+  }
+
+  int orient;
+  for(orient = 0; orient < 3; orient++){
+    char* match = colors_of(moved_piece, (moved_pos * 3) + orient);
+    if(match[0] == moved_colors[0] && match[1] == moved_colors[1] &&
+       match[2] == moved_colors[2]) return (moved_pos * 3) + orient;
+  }
+  return -1;
+}
+
+/** This function returns the colors of a piece in a state (see cube.c)
+  * @param piece The piece
+  * @param state The state of the piece
+  * @return Which of the piece's colors faces top/bottom, front/back and
+  *    left/right
+  */
+char* colors_of(int piece, int state){
+  if (piece == 0 || piece == 3 || piece == 5 || piece == 6)
+    return state_table0356[state];
+  return state_table1247[state];
+}
+
+/** This function finds where a cube is stored in the symmetry table
+  * @param cube The cube
+  * @param symmetry Filled with the symmetry that moves the cube to the stored
+  *    cube
+  * @return The index of the stored cube
+  * @return -1 cube does not exist
+  */
+int symmetry_index(int cube, int* symmetry){
+  int rank = rank_cube(cube);
+  if(rank == -1) return -1;
+  *symmetry = canonical_symmetry[rank / NUMBER_OF_ORIENTATIONS];
+  int moved = rank_cube(conjugate_cube(cube, *symmetry));
+  return (perm_class[moved / NUMBER_OF_ORIENTATIONS] * NUMBER_OF_ORIENTATIONS) +
+         (moved % NUMBER_OF_ORIENTATIONS);
+}
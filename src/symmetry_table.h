@@ -0,0 +1,32 @@
+/** File: symmetry_table.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the function prototypes for the file symmetry_table.c
+  */
+
+#ifndef SYMMETRY_TABLE_H
+#define SYMMETRY_TABLE_H
+
+#include <stdint.h>
+#include "state_table.h"
+#include "cube.h"
+
+#define NUMBER_OF_SYMMETRIES 6 //symmetries that keep piece 7 in place
+#define PERMUTATION_CLASSES 870 //permutations left after the symmetries
+#define SYMMETRY_TABLE_STATES (PERMUTATION_CLASSES * NUMBER_OF_ORIENTATIONS)
+#define SYMMETRY_TABLE_WORDS \
+  ((SYMMETRY_TABLE_STATES + TURNS_PER_WORD - 1) / TURNS_PER_WORD)
+
+//Function Prototypes
+int init_symmetries();
+int conjugate_cube(int cube, int symmetry);
+int conjugate_turn(char turn, int symmetry);
+
+uint64_t* make_symmetry_table();
+int reduce_ranked_table(const uint64_t* ranked_table, uint64_t* symmetry_table);
+void write_symmetry_table(const uint64_t* symmetry_table);
+char get_symmetry_turn(const uint64_t* symmetry_table, int cube);
+int solve_symmetry_cube_into(int cube, const uint64_t* symmetry_table,
+                             char* turn_sequence);
+
+#endif
@@ -0,0 +1,639 @@
+/** File: table_file.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the functions used to save and load state tables.
+  *
+  * A table file holds a TableHeader (see table_file.h) followed by the table
+  * data. Loading a table maps the file read-only instead of reading it into 
+  * memory, so starting the solver costs the same no matter the table size, 
+  * and every process using the table shares a single copy of it.
+  *
+  * The header records the format version, the encoding of the data and a 
+  * checksum, so a table that is out of date or of the wrong format is
+  * rejected instead of producing garbage moves. Checking the checksum reads
+  * the whole table, so it is only done when asked (solver -v).
+  *
+  * The original state_table.bin has no header. It is read as the table
+  * ranked_table.bin is built from (see load_state_table), or used as it is
+  * when it is named (solver -t file), after checking that every entry is in
+  * order and holds a turn. A file without a header that is not such a table
+  * is rejected.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "table_file.h"
+#include "state_table.h"
+#include "depth_table.h"
+#include "symmetry_table.h"
+#include "packed_solution.h"
+#include "lazy_table.h"
+#include "search.h"
+#include "sorted_index.h"
+#include "puzzle.h"
+#include "metrics.h"
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+#define PACKED_BATCH 256 //cubes solved per call to solve_batch (packed)
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+size_t encoding_size(int encoding, uint32_t states);
+int check_header(const TableHeader* header, size_t file_size, int verify);
+StateTable* map_table_file(const char* file_name, size_t* file_size);
+StateTable* open_legacy_table(const char* file_name);
+int has_table_header(const char* file_name);
+int check_legacy_table(const unsigned char* state_table);
+char encoding_get_turn(const StateTable* table, int cube);
+int encoding_solve_into(const StateTable* table, int cube,
+                        char* turn_sequence);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~ Table File Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function maps a table file into memory (read-only) and checks its 
+  * header. Only the header is read, so opening a table costs the same no
+  * matter its size: the checksum of the data is verified only when asked
+  * (see verify_state_table).
+  * @param file_name The table file to open
+  * @param verify 1 to also verify the checksum of the data
+  * @return Pointer to the loaded table
+  * @return NULL The file is missing, or is not a valid table
+  */
+StateTable* open_state_table(const char* file_name, int verify){
+  METRIC_TIMER(start);
+  size_t file_size;
+  StateTable* table = map_table_file(file_name, &file_size);
+  if(table == NULL) return NULL;
+
+  const TableHeader* header = (const TableHeader*) table->map;
+  if(file_size < sizeof(TableHeader) ||
+     memcmp(header->magic, TABLE_MAGIC, sizeof(header->magic)) != 0 ||
+     !check_header(header, file_size, verify)){
+    fprintf(stderr, "%s is not a valid state table.\n", file_name);
+    close_state_table(table);
+    return NULL;
+  }
+  table->encoding = header->encoding;
+  table->data = (const char*) table->map + header->header_size;
+  table->data_size = header->data_size;
+  METRIC_ADD(METRIC_TABLE_LOADS, 1);
+  METRIC_ADD_ELAPSED(METRIC_TABLE_LOAD_NS, start);
+  return table;
+}
+
+/** This function verifies the checksum of a table's data against its header
+  * @param table The loaded table
+  * @return 1 The data matches the checksum (or the table has no header)
+  * @return 0 The data is corrupt
+  */
+int verify_state_table(const StateTable* table){
+  if(table->map == NULL || table->data == table->map) return 1;
+  const TableHeader* header = (const TableHeader*) table->map;
+  return table_checksum(table->data, table->data_size) == header->checksum;
+}
+
+/** This function unmaps a table (or stops a lazy table) and frees it.
+  * @param table The table to close
+  */
+void close_state_table(StateTable* table){
+  if(table == NULL) return;
+  if(table->encoding == TABLE_LAZY){
+    close_lazy_table(table);
+    return;
+  }
+  free_sorted_index(table->index);
+  if(table->map != NULL) munmap(table->map, table->map_size);
+  free(table);
+}
+
+/** This function loads the ranked table from ranked_table.bin. If that file
+  * does not exist yet, it is decoded from mod3_table.bin (under 1 MB, for
+  * small installs) or built from the sorted state_table.bin, and saved so
+  * that later runs can map it directly. If it cannot be saved, the table it
+  * was built from is used instead. When there is no table at all, or the
+  * caller does not want to wait for one, a lazy table generates it in the
+  * background while cubes are solved by search (see lazy_table.c). A sorted
+  * table that is used as it is is searched directly, unless it is indexed
+  * (see index_state_table).
+  * @param file_name A table file to load instead (of any encoding, or a
+  *    sorted table without a header), or NULL
+  * @param lazy 1 to use a lazy table unless ranked_table.bin can be mapped
+  * @return Pointer to the loaded table
+  * @return NULL No table could be loaded
+  */
+StateTable* load_state_table(const char* file_name, int lazy){
+  if(file_name != NULL){
+    if(!has_table_header(file_name)) return open_legacy_table(file_name);
+    return open_state_table(file_name, 0);
+  }
+
+  StateTable* state_table = open_state_table("ranked_table.bin", 0);
+  if(state_table != NULL) return state_table;
+  if(lazy) return open_lazy_table("ranked_table.bin");
+
+  StateTable* mod3_table = open_state_table("mod3_table.bin", 0);
+  if(mod3_table != NULL && mod3_table->encoding == TABLE_DEPTH_MOD3){
+    METRIC_TIMER(decode_start);
+    uint64_t* ranked_table = make_ranked_table();
+    if(ranked_table != NULL &&
+       decode_mod3_table(mod3_table->data, ranked_table)){
+      METRIC_ADD_ELAPSED(METRIC_TABLE_DECODE_NS, decode_start);
+      write_ranked_table(ranked_table);
+      state_table = open_state_table("ranked_table.bin", 0);
+    }
+    free(ranked_table);
+    if(state_table == NULL){
+      state_table = mod3_table; //solve from the mod 3 table
+    }else{
+      close_state_table(mod3_table);
+    }
+    return state_table;
+  }
+  if(mod3_table != NULL) close_state_table(mod3_table);
+
+  StateTable* sorted_table = open_legacy_table("state_table.bin");
+  if(sorted_table == NULL){
+    fprintf(stderr, "No state table was found, solving by search while "
+                    "ranked_table.bin is generated.\n");
+    return open_lazy_table("ranked_table.bin");
+  }
+  if(sorted_table->encoding != TABLE_SORTED) return sorted_table;
+
+  METRIC_TIMER(rank_start);
+  uint64_t* ranked_table = make_ranked_table();
+  if(ranked_table != NULL &&
+     rank_state_table(sorted_table->data, ranked_table)){
+    METRIC_ADD_ELAPSED(METRIC_TABLE_DECODE_NS, rank_start);
+    write_ranked_table(ranked_table);
+    state_table = open_state_table("ranked_table.bin", 0);
+  }
+  free(ranked_table);
+
+  if(state_table == NULL){
+    state_table = sorted_table; //fall back on the sorted table
+  }else{
+    close_state_table(sorted_table);
+  }
+  return state_table;
+}
+
+/** This function builds an index over a sorted table (see sorted_index.c),
+  * about 20 MB that makes each lookup take fewer cache misses than the
+  * binary search. Other encodings do not need one.
+  * @param table The table to index
+  * @return 1 The table is indexed, or does not need an index
+  * @return 0 There is no memory for the index
+  */
+int index_state_table(StateTable* table){
+  if(table->encoding != TABLE_SORTED || table->index != NULL) return 1;
+  table->index = build_sorted_index(table->data);
+  return table->index != NULL;
+}
+
+/** This function writes table data to a file, after a header describing it.
+  * The data is written to a temporary file first and then renamed, so 
+  * processes that have the old table mapped are not affected.
+  * @param file_name The file to write
+  * @param encoding The encoding of the data (TABLE_SORTED, TABLE_RANKED...)
+  * @param data The table data
+  * @param data_size The number of bytes of data
+  * @return 1 The table was saved
+  * @return 0 An error occured
+  */
+int save_state_table(const char* file_name, int encoding, const void* data,
+                     size_t data_size){
+  return save_table_states(file_name, encoding, NUMBER_OF_CUBES, data,
+                           data_size);
+}
+
+/** This function writes table data to a file (see save_state_table), for a
+  * table that does not hold one entry per cube (EX: TABLE_PUZZLE).
+  * @param file_name The file to write
+  * @param encoding The encoding of the data
+  * @param states The number of states in the table
+  * @param data The table data
+  * @param data_size The number of bytes of data
+  * @return 1 The table was saved
+  * @return 0 An error occured
+  */
+int save_table_states(const char* file_name, int encoding, uint32_t states,
+                      const void* data, size_t data_size){
+  TableHeader header;
+  memset(&header, 0, sizeof(TableHeader));
+  memcpy(header.magic, TABLE_MAGIC, sizeof(header.magic));
+  header.version = TABLE_VERSION;
+  header.encoding = encoding;
+  header.states = states;
+  header.header_size = sizeof(TableHeader);
+  header.data_size = data_size;
+  header.checksum = table_checksum(data, data_size);
+
+  char temp_name[256];
+  if(snprintf(temp_name, sizeof(temp_name), "%s.tmp", file_name) >=
+     (int) sizeof(temp_name)) return 0;
+
+  FILE* file = fopen(temp_name, "wb");
+  if(file == NULL) return 0;
+  int written = fwrite(&header, sizeof(TableHeader), 1, file) == 1 &&
+                fwrite(data, 1, data_size, file) == data_size;
+  written = (fclose(file) == 0) && written;
+
+  if(!written || rename(temp_name, file_name) != 0){
+    remove(temp_name);
+    return 0;
+  }
+  return 1;
+}
+
+/** This function computes the 64 bit FNV-1a checksum of the table data.
+  * @param data The table data
+  * @param data_size The number of bytes of data
+  * @return The checksum
+  */
+uint64_t table_checksum(const void* data, size_t data_size){
+  const unsigned char* bytes = (const unsigned char*) data;
+  uint64_t checksum = FNV_OFFSET;
+  size_t i;
+  for(i = 0; i < data_size; i++){
+    checksum = (checksum ^ bytes[i]) * FNV_PRIME;
+  }
+  return checksum;
+}
+
+/** This function returns the turn used to reach a cube, for a table of any
+  * encoding.
+  * @param table The loaded table
+  * @param cube the Cube for which to find the turn.
+  * @return a number between 1 and 6 representing the turn.
+  *   (see the turn codes in cube.h)
+  * @return -1 cube does not exist
+  */
+char table_get_turn(const StateTable* table, int cube){
+  METRIC_TIMER(start);
+  char turn = encoding_get_turn(table, cube);
+  METRIC_OBSERVE_ELAPSED(METRIC_GET_TURN_NS, start);
+  return turn;
+}
+
+/** This funciton solves a cube using a table of any encoding.
+  * @param cube The cube to be solved
+  * @param table The loaded table
+  * @return A character array representing the turns needed to solve the cube. 
+  *    (see the turn codes in cube.h)
+  * @return NULL signal an error (invalid cube)
+  */
+char* table_solve_cube(const StateTable* table, int cube){
+  METRIC_TIMER(start);
+  char* turn_sequence = NULL;
+  switch(table->encoding){
+    case TABLE_SORTED:
+      turn_sequence = solve_cube(cube, table->data);
+      break;
+    case TABLE_RANKED:
+      turn_sequence = solve_ranked_cube(cube, (const uint64_t*) table->data);
+      break;
+    case TABLE_DEPTH:
+    case TABLE_SYMMETRY:
+    case TABLE_DEPTH_MOD3:
+    case TABLE_LAZY:
+    case TABLE_SEARCH:
+    case TABLE_IDA:
+      turn_sequence = (char*) malloc(SOLUTION_SIZE);
+      if(turn_sequence != NULL &&
+         table_solve_cube_into(table, cube, turn_sequence) == -1){
+        free(turn_sequence);
+        return NULL;
+      }
+      return turn_sequence; //recorded by table_solve_cube_into
+  }
+  METRIC_SOLVED(turn_sequence == NULL ? -1 : (int) strlen(turn_sequence));
+  METRIC_OBSERVE_ELAPSED(METRIC_SOLVE_NS, start);
+  return turn_sequence;
+}
+
+/** This function solves a batch of cubes using a table of any encoding.
+  * Ranked and sorted tables (and lazy tables, once generated) solve the
+  * batch together (see solve_ranked_batch and solve_sorted_batch).
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param table The loaded table
+  * @param solutions n * SOLUTION_SIZE chars, filled with the turns for each 
+  *    cube (as returned by solve_cube). An invalid cube is given the single
+  *    turn -1.
+  * @return The number of cubes that were solved
+  */
+size_t solve_batch(const int* cubes, size_t n, const StateTable* table,
+                   char* solutions){
+  METRIC_TIMER(start);
+  size_t solved = 0;
+  if(table->encoding == TABLE_RANKED || table->encoding == TABLE_SORTED ||
+     table->encoding == TABLE_LAZY){
+    if(table->encoding == TABLE_RANKED){
+      solved = solve_ranked_batch(cubes, n, (const uint64_t*) table->data,
+                                  solutions);
+    }else if(table->encoding == TABLE_SORTED){
+      solved = solve_sorted_batch(cubes, n,
+                                  (const unsigned char*) table->data,
+                                  table->index, solutions);
+    }else{
+      solved = solve_lazy_batch(cubes, n, (const LazyTable*) table->data,
+                                solutions);
+    }
+    METRIC_BATCH(solutions, n);
+    METRIC_OBSERVE_ELAPSED(METRIC_BATCH_NS, start);
+    return solved;
+  }
+
+  size_t i;
+  for(i = 0; i < n; i++){
+    char* solution = &solutions[i * SOLUTION_SIZE];
+    memset(solution, 0, SOLUTION_SIZE);
+    if(table_solve_cube_into(table, cubes[i], solution) == -1){
+      memset(solution, 0, SOLUTION_SIZE);
+      solution[0] = -1;
+      continue;
+    }
+    solved++;
+  }
+  METRIC_OBSERVE_ELAPSED(METRIC_BATCH_NS, start);
+  return solved;
+}
+
+/** This function solves a batch of cubes into packed solutions, 8 bytes per
+  * cube instead of SOLUTION_SIZE (see solve_batch).
+  * @param cubes The cubes to be solved
+  * @param n The number of cubes
+  * @param table The loaded table
+  * @param solutions Filled with the packed solution of each cube, or
+  *    PACKED_SOLUTION_INVALID for an invalid cube
+  * @return The number of cubes that were solved
+  */
+size_t solve_batch_packed(const int* cubes, size_t n, const StateTable* table,
+                          PackedSolution* solutions){
+  char turns[PACKED_BATCH * SOLUTION_SIZE];
+  size_t solved = 0;
+  size_t done;
+  for(done = 0; done < n; done += PACKED_BATCH){
+    size_t count = (n - done < PACKED_BATCH) ? n - done : PACKED_BATCH;
+    solved += solve_batch(&cubes[done], count, table, turns);
+    size_t i;
+    for(i = 0; i < count; i++){
+      solutions[done + i] = pack_solution(&turns[i * SOLUTION_SIZE]);
+    }
+  }
+  return solved;
+}
+
+/** This funciton solves a cube using a table of any encoding, into a buffer
+  * owned by the caller.
+  * @param cube The cube to be solved
+  * @param table The loaded table
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns needed to
+  *    solve the cube followed by the terminator (0)
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int table_solve_cube_into(const StateTable* table, int cube, 
+                          char* turn_sequence){
+  METRIC_TIMER(start);
+  int length = encoding_solve_into(table, cube, turn_sequence);
+  METRIC_SOLVED(length);
+  METRIC_OBSERVE_ELAPSED(METRIC_SOLVE_NS, start);
+  return length;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function finds the turn for a cube in a table of any encoding (see
+  * table_get_turn).
+  * @param table The loaded table
+  * @param cube The cube
+  * @return a number between 1 and 6 representing the turn.
+  * @return -1 cube does not exist
+  */
+char encoding_get_turn(const StateTable* table, int cube){
+  switch(table->encoding){
+    case TABLE_SORTED:
+      if(table->index != NULL) return get_indexed_turn(table->index, cube);
+      return get_turn(table->data, cube);
+    case TABLE_RANKED:
+      return get_ranked_turn((const uint64_t*) table->data, cube);
+    case TABLE_DEPTH:
+      return get_depth_turn((const uint8_t*) table->data, cube);
+    case TABLE_SYMMETRY:
+      return get_symmetry_turn((const uint64_t*) table->data, cube);
+    case TABLE_DEPTH_MOD3:
+      return get_mod3_turn((const uint8_t*) table->data, cube);
+    case TABLE_LAZY:
+      return get_lazy_turn((const LazyTable*) table->data, cube);
+    case TABLE_SEARCH:
+    case TABLE_IDA: {
+      char turn_sequence[SOLUTION_SIZE];
+      if(search_table_solve_into(table, cube, turn_sequence) == -1) return -1;
+      return turn_sequence[0];
+    }
+  }
+  return -1;
+}
+
+/** This function solves a cube with a table of any encoding (see
+  * table_solve_cube_into).
+  * @param table The loaded table
+  * @param cube The cube to be solved
+  * @param turn_sequence SOLUTION_SIZE chars, filled with the turns
+  * @return The number of turns
+  * @return -1 signal an error (invalid cube)
+  */
+int encoding_solve_into(const StateTable* table, int cube,
+                        char* turn_sequence){
+  switch(table->encoding){
+    case TABLE_SORTED:
+      if(table->index != NULL){
+        return solve_indexed_cube_into(cube, table->index, turn_sequence);
+      }
+      return solve_cube_into(cube, table->data, turn_sequence);
+    case TABLE_RANKED:
+      return solve_ranked_cube_into(cube, (const uint64_t*) table->data,
+                                    turn_sequence);
+    case TABLE_DEPTH:
+      return solve_depth_cube_into(cube, (const uint8_t*) table->data,
+                                   turn_sequence);
+    case TABLE_SYMMETRY:
+      return solve_symmetry_cube_into(cube, (const uint64_t*) table->data,
+                                      turn_sequence);
+    case TABLE_DEPTH_MOD3:
+      return solve_mod3_cube_into(cube, (const uint8_t*) table->data,
+                                  turn_sequence);
+    case TABLE_LAZY:
+      return solve_lazy_cube_into(cube, (const LazyTable*) table->data,
+                                  turn_sequence);
+    case TABLE_SEARCH:
+    case TABLE_IDA:
+      return search_table_solve_into(table, cube, turn_sequence);
+  }
+  return -1;
+}
+
+/** This function returns the size of the data for an encoding
+  * @param encoding The encoding of the table
+  * @param states The number of states in the table
+  * @return The number of bytes of data
+  * @return 0 The encoding is unknown, or does not have that many states
+  *    (a puzzle table has the states of one of the puzzles)
+  */
+size_t encoding_size(int encoding, uint32_t states){
+  if(encoding == TABLE_PUZZLE){
+    const Puzzle* puzzle;
+    int index;
+    for(index = 0; (puzzle = puzzle_at(index)) != NULL; index++){
+      if((uint32_t) puzzle_states(puzzle) == states){
+        return puzzle_table_size((int) states);
+      }
+    }
+    return 0;
+  }
+  if(states != NUMBER_OF_CUBES) return 0;
+  switch(encoding){
+    case TABLE_SORTED:
+      return (size_t) NUMBER_OF_CUBES * SIZE_OF_CUBE;
+    case TABLE_RANKED:
+      return RANKED_TABLE_WORDS * sizeof(uint64_t);
+    case TABLE_DEPTH:
+      return DEPTH_TABLE_SIZE;
+    case TABLE_SYMMETRY:
+      return SYMMETRY_TABLE_WORDS * sizeof(uint64_t);
+    case TABLE_DEPTH_MOD3:
+      return MOD3_TABLE_SIZE;
+  }
+  return 0;
+}
+
+/** This function checks that a table header describes a table this version
+  * of the solver can use.
+  * @param header The header at the start of the file
+  * @param file_size The size of the file
+  * @param verify 1 to also verify the checksum of the data
+  * @return 1 The header is valid
+  * @return 0 The table must not be used
+  */
+int check_header(const TableHeader* header, size_t file_size, int verify){
+  if(header->version != TABLE_VERSION) return 0;
+  if(header->header_size != sizeof(TableHeader)) return 0;
+  size_t data_size = encoding_size(header->encoding, header->states);
+  if(data_size == 0) return 0; //unknown encoding (or number of states)
+  if(header->data_size != data_size) return 0;
+  if(header->data_size != file_size - sizeof(TableHeader)) return 0;
+
+  if(verify){
+    const char* data = (const char*) header + header->header_size;
+    if(table_checksum(data, header->data_size) != header->checksum) return 0;
+  }
+  return 1;
+}
+
+/** This function maps a file into memory (read-only), for a table that has
+  * not been checked yet.
+  * @param file_name The file to map
+  * @param file_size Set to the size of the file
+  * @return Pointer to a table holding the mapping (no encoding or data yet)
+  * @return NULL The file is missing or empty, or out of memory
+  */
+StateTable* map_table_file(const char* file_name, size_t* file_size){
+  int fd = open(file_name, O_RDONLY);
+  if(fd == -1) return NULL;
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) == -1 || file_stat.st_size == 0){
+    close(fd);
+    return NULL;
+  }
+  *file_size = (size_t) file_stat.st_size;
+
+  void* map = mmap(NULL, *file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); //the mapping stays valid after the file is closed
+  if(map == MAP_FAILED) return NULL;
+
+  StateTable* table = (StateTable*) calloc(1, sizeof(StateTable));
+  if(table == NULL){
+    munmap(map, *file_size);
+    return NULL;
+  }
+  table->map = map;
+  table->map_size = *file_size;
+  return table;
+}
+
+/** This function maps the original state_table.bin, which has no header, as
+  * a TABLE_SORTED table. It is read in full to check it, since there is no
+  * header or checksum describing it.
+  * @param file_name The file to open
+  * @return Pointer to the loaded table
+  * @return NULL The file is missing, or is not a sorted state table
+  */
+StateTable* open_legacy_table(const char* file_name){
+  size_t file_size;
+  StateTable* table = map_table_file(file_name, &file_size);
+  if(table == NULL) return NULL;
+  if(file_size != encoding_size(TABLE_SORTED, NUMBER_OF_CUBES) ||
+     memcmp(table->map, TABLE_MAGIC, strlen(TABLE_MAGIC)) == 0 ||
+     !check_legacy_table((const unsigned char*) table->map)){
+    fprintf(stderr, "%s is not a valid state table.\n", file_name);
+    close_state_table(table);
+    return NULL;
+  }
+  table->encoding = TABLE_SORTED;
+  table->data = table->map;
+  table->data_size = file_size;
+  return table;
+}
+
+/** This function checks if a file starts with a table header, without
+  * mapping it
+  * @param file_name The file to check
+  * @return 1 The file starts with TABLE_MAGIC
+  * @return 0 The file is missing, or has no header
+  */
+int has_table_header(const char* file_name){
+  char magic[sizeof(TABLE_MAGIC) - 1];
+  FILE* file = fopen(file_name, "rb");
+  if(file == NULL) return 0;
+  size_t count = fread(magic, 1, sizeof(magic), file);
+  fclose(file);
+  return count == sizeof(magic) &&
+         memcmp(magic, TABLE_MAGIC, sizeof(magic)) == 0;
+}
+
+/** This function checks a sorted state table without a header: the cubes
+  * must be in increasing order, every turn must be 0 - 6, and only the
+  * solved cube is reached by no turn.
+  * @param state_table The sorted state table
+  * @return 1 The table is a sorted state table
+  * @return 0 The table must not be used
+  */
+int check_legacy_table(const unsigned char* state_table){
+  int last = -1;
+  int i;
+  for(i = 0; i < NUMBER_OF_CUBES; i++){
+    int cube = sorted_cube_at(state_table, i);
+    char turn = (char) state_table[(i * SIZE_OF_CUBE) + 4];
+    if(cube <= last || turn < 0 || turn > 0x06) return 0;
+    if((turn == 0) != (cube == SOLVED_CUBE)) return 0;
+    last = cube;
+  }
+  return 1;
+}
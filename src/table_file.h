@@ -0,0 +1,78 @@
+/** File: table_file.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the table header and the function prototypes for the 
+  * file table_file.c
+  */
+
+#ifndef TABLE_FILE_H
+#define TABLE_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "packed_solution.h"
+
+#define TABLE_MAGIC "2X2TABLE" //first 8 bytes of every table file
+#define TABLE_VERSION 1
+
+//Encodings of the data that follows the header
+#define TABLE_SORTED 1 //sorted 5 byte entries (big endian cube, then turn)
+#define TABLE_RANKED 2 //3 bit turns indexed by rank, 21 per 64 bit word
+#define TABLE_DEPTH 3 //4 bit depths indexed by rank, 2 per byte
+#define TABLE_SYMMETRY 4 //3 bit turns of one cube per symmetry class
+#define TABLE_DEPTH_MOD3 5 //2 bit depths modulo 3 indexed by rank, 4 per byte
+#define TABLE_LAZY 6 //generated in memory while solving by search (no file)
+#define TABLE_SEARCH 7 //bidirectional search, no table (no file)
+#define TABLE_IDA 8 //IDA* search with small distance tables (no file)
+#define TABLE_PUZZLE 9 //4 bit moves of a variant of the cube (see puzzle.h)
+
+/** The following header is stored at the start of every table file, in the 
+  * byte order of the machine that wrote it. The table data follows directly
+  * after the header, so it stays 8 byte aligned when the file is mapped.
+  */
+typedef struct TableHeader {
+  char magic[8];        //TABLE_MAGIC
+  uint32_t version;     //TABLE_VERSION
+  uint32_t encoding;    //TABLE_SORTED, TABLE_RANKED...
+  uint32_t states;      //number of cube states in the table (the states of
+                        //the puzzle for TABLE_PUZZLE)
+  uint32_t header_size; //sizeof(TableHeader)
+  uint64_t data_size;   //number of bytes after the header
+  uint64_t checksum;    //FNV-1a checksum of the data
+  uint64_t reserved[3]; //pads the header to 64 bytes
+} TableHeader;
+
+/** A loaded table. The data is mapped read-only from the file and is shared
+  * through the page cache with every other process using the same file.
+  */
+typedef struct StateTable {
+  int encoding;         //TABLE_SORTED, TABLE_RANKED...
+  const void* data;     //the table data (after the header)
+  size_t data_size;     //number of bytes of data
+  void* map;            //start of the mapping (NULL when there is no file)
+  size_t map_size;      //length of the mapping
+  struct SortedIndex* index; //index over a sorted table (see
+                             //index_state_table), or NULL
+} StateTable;
+
+//Function Prototypes
+StateTable* open_state_table(const char* file_name, int verify);
+int verify_state_table(const StateTable* table);
+StateTable* load_state_table(const char* file_name, int lazy);
+int index_state_table(StateTable* table);
+void close_state_table(StateTable* table);
+int save_state_table(const char* file_name, int encoding, const void* data,
+                     size_t data_size);
+int save_table_states(const char* file_name, int encoding, uint32_t states,
+                      const void* data, size_t data_size);
+uint64_t table_checksum(const void* data, size_t data_size);
+char table_get_turn(const StateTable* table, int cube);
+char* table_solve_cube(const StateTable* table, int cube);
+int table_solve_cube_into(const StateTable* table, int cube, 
+                          char* turn_sequence);
+size_t solve_batch(const int* cubes, size_t n, const StateTable* table,
+                   char* solutions);
+size_t solve_batch_packed(const int* cubes, size_t n, const StateTable* table,
+                          PackedSolution* solutions);
+
+#endif
@@ -0,0 +1,1153 @@
+/** File: test.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the tests of the solver (make test).
+  *
+  * The tables are generated in memory, so no table file is written. Only
+  * the shipped state_table.bin is read, as solver -t state_table.bin does.
+  * Each failed check is written to stdout as one line:
+  *   FAIL <test> <what was checked>
+  * followed by the number of checks that passed and failed. The program
+  * returns 1 when a check failed. The random cubes come from a fixed seed.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "cube.h"
+#include "state_table.h"
+#include "table_file.h"
+#include "search.h"
+#include "sorted_index.h"
+#include "parse.h"
+#include "session.h"
+#include "puzzle.h"
+#include "queue.h"
+#include "scramble.h"
+#include "lazy_table.h"
+#include "depth_table.h"
+#include "packed_solution.h"
+#include "solution_cache.h"
+#include "packed_cube.h"
+
+#define TEST_SEED 0x2B2B2B2Bu //seed of the random cubes
+#define PARSE_CUBES 10000 //random cubes converted to colors and back
+#define OPTIMAL_CUBES 200 //random cubes solved by the table and by search
+#define LEGACY_CUBES 10000 //random cubes solved with state_table.bin
+#define SORTED_CUBES 4096 //random cubes looked up in one batch
+#define SESSION_CUBES 100 //random cubes followed through a session
+#define PUZZLE_CUBES 1000 //random cubes solved by each puzzle
+#define WALK_TURNS 12 //turns of the random walks in the <F,U> subgroup
+#define MPMC_THREADS 4 //producers, and as many consumers, sharing a queue
+#define MPMC_ITEMS 100000 //entries enqueued by each producer
+#define MPMC_CELLS 64 //cells of the shared queue, so it is often full
+#define SCRAMBLE_CUBES 200 //cubes scrambled at each depth
+#define QUEUE64_ENTRIES ((3 * QUEUE64_SEGMENT) + 5) //entries over 4 segments
+#define SPSC_ENTRIES 1000000 //entries passed from one thread to another
+#define SPSC_CELLS 1000 //cells asked for the SPSC queue (1024 are made)
+#define QUEUE_VALUE(i) ((uint64_t) (i) * 0x9E3779B97F4A7C15ULL) //whole words
+#define LAZY_CUBES 100 //random cubes solved before and after the switch
+#define LAZY_WAIT_MS 120000 //longest wait for the lazy table to be generated
+#define MOD3_CUBES 10000 //random cubes solved with the mod 3 table
+#define PACKED_SOLUTIONS 1000 //random cubes solved into packed solutions
+#define CACHE_CUBES 1000 //random cubes solved through the solution cache
+#define PACKED_CUBES 10000 //random cubes packed, turned and ranked
+#define BATCH_CUBES 1003 //cubes moved in one batch (not a multiple of 8)
+
+#define CHECK(test, condition) check(test, condition, #condition)
+
+static const char* solved_colors = "oooo gggg wwww bbbb yyyy rrrr";
+static int passed = 0;
+static int failed = 0;
+
+//the queue shared by the producers and consumers of test_mpmc
+typedef struct MPMCTest {
+  MPMCQueue* queue;
+  atomic_int* seen;     //times each entry was dequeued
+  atomic_int producer;  //the next producer to start
+} MPMCTest;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void test_parse();
+void test_optimal(const StateTable* table);
+void test_legacy(const StateTable* table);
+void test_sorted();
+void check_sorted_batch(const unsigned char* state_table,
+                        const SortedIndex* index, int* cubes, char* turns,
+                        char* solutions);
+void test_session(const StateTable* table);
+void test_puzzles(const StateTable* table);
+void test_puzzle(const char* name, const StateTable* table);
+void test_mpmc();
+void test_batch_moves();
+void test_packed_cubes();
+void test_cache(const StateTable* table);
+void test_packed_solutions(const StateTable* table);
+void test_mod3(const StateTable* table);
+void test_lazy(const StateTable* table);
+int check_lazy_batch(const StateTable* lazy, const StateTable* table,
+                     const int* cubes, char* solutions);
+void test_queue64();
+void test_spsc();
+void test_scramble(const StateTable* table);
+
+int check(const char* test, int condition, const char* what);
+void* mpmc_producer(void* argument);
+void* mpmc_consumer(void* argument);
+void* spsc_producer(void* argument);
+uint32_t next_random(uint32_t* state);
+int random_cube(uint32_t* state);
+void cube_colors(int cube, char* colors);
+int apply_turns(int cube, const char* turns);
+int apply_puzzle_moves(const Puzzle* puzzle, int cube, const char* moves);
+PuzzleTable* make_puzzle(const Puzzle* puzzle);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Test Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+int main(){
+  uint64_t* ranked_table = make_ranked_table();
+  if(ranked_table == NULL || !generate_ranked_table(ranked_table)){
+    printf("The ranked table could not be generated.\n");
+    return 1;
+  }
+  StateTable table = {TABLE_RANKED, ranked_table,
+                      RANKED_TABLE_WORDS * sizeof(uint64_t), NULL, 0, NULL};
+
+  test_parse();
+  test_optimal(&table);
+  test_legacy(&table);
+  test_sorted();
+  test_session(&table);
+  test_puzzles(&table);
+  test_mpmc();
+  test_batch_moves();
+  test_packed_cubes();
+  test_cache(&table);
+  test_packed_solutions(&table);
+  test_mod3(&table);
+  test_lazy(&table);
+  test_queue64();
+  test_spsc();
+  test_scramble(&table);
+
+  free(ranked_table);
+  printf("%d checks passed, %d failed\n", passed, failed);
+  return failed ? 1 : 0;
+}
+
+/** This function tests the conversion of text into cubes: the colors of
+  * every cube convert back into it, and invalid colors or lines are
+  * rejected.
+  */
+void test_parse(){
+  char line[LINE_SIZE];
+  strcpy(line, solved_colors);
+  CHECK("parse", parse_line(line) == SOLVED_CUBE);
+
+  char colors[BUFF_SIZE];
+  cube_colors(SOLVED_CUBE, colors);
+  CHECK("parse", memcmp(colors, "oooogggg", 8) == 0);
+  CHECK("parse", compress(colors) == SOLVED_CUBE);
+
+  uint32_t seed = TEST_SEED;
+  int i, round_trips = 0;
+  for(i = 0; i < PARSE_CUBES; i++){
+    int cube = random_cube(&seed);
+    cube_colors(cube, colors);
+    if(compress(colors) == cube && check_colors(colors) == 0) round_trips++;
+  }
+  CHECK("parse", round_trips == PARSE_CUBES);
+
+  //a twisted corner has valid colors, but is not a cube
+  memcpy(colors, "oogogwggowwwbbbbyyyyrrrr", BUFF_SIZE);
+  CHECK("parse", compress(colors) == -2);
+  strcpy(line, "oogogwggowwwbbbbyyyyrrrr");
+  CHECK("parse", parse_line(line) == -1);
+
+  strcpy(line, "oooo gggg wwww bbbb yyyy rrrx");
+  CHECK("parse", parse_line(line) == -1);
+  strcpy(line, "oooo gggg wwww bbbb yyyy rrr");
+  CHECK("parse", parse_line(line) == -1);
+  strcpy(line, "oooo gggg wwww bbbb yyyy rrrr r");
+  CHECK("parse", parse_line(line) == -1);
+
+  snprintf(line, sizeof(line), "  %d\r\n", SOLVED_CUBE);
+  CHECK("parse", parse_line(line) == SOLVED_CUBE);
+  strcpy(line, "12abc");
+  CHECK("parse", parse_line(line) == -1);
+
+  CHECK("parse", parse_turn("F'") == 1 && parse_turn("TC") == 6);
+}
+
+/** This function tests that the table solves cubes optimally: each
+  * solution solves its cube, and is as short as the one found by search.
+  * @param table The ranked table
+  */
+void test_optimal(const StateTable* table){
+  char turns[SOLUTION_SIZE];
+  char shortest[SOLUTION_SIZE];
+  CHECK("optimal", table_solve_cube_into(table, SOLVED_CUBE, turns) == 0);
+  CHECK("optimal", table_solve_cube_into(table, 0, turns) == -1);
+
+  uint32_t seed = TEST_SEED;
+  int i, solved = 0, optimal = 0;
+  for(i = 0; i < OPTIMAL_CUBES; i++){
+    int cube = random_cube(&seed);
+    int length = table_solve_cube_into(table, cube, turns);
+    if(length >= 0 && apply_turns(cube, turns) == SOLVED_CUBE) solved++;
+    if(length == ida_solve_cube_into(cube, shortest)) optimal++;
+  }
+  CHECK("optimal", solved == OPTIMAL_CUBES);
+  CHECK("optimal", optimal == OPTIMAL_CUBES);
+
+  //a cube one turn from solved is solved by the turn that undoes it
+  for(i = 0; i < 6; i++){
+    int length = table_solve_cube_into(table, rotate(SOLVED_CUBE, i), turns);
+    CHECK("optimal", length == 1 && turns[0] == (i ^ 1) + 1);
+  }
+}
+
+/** This function tests the shipped state_table.bin, which has no header: it
+  * loads as a sorted table when it is named, and solves cubes as the ranked
+  * table does.
+  * @param table The ranked table
+  */
+void test_legacy(const StateTable* table){
+  StateTable* sorted_table = load_state_table("state_table.bin", 0);
+  CHECK("legacy", sorted_table != NULL);
+  if(sorted_table == NULL) return;
+  CHECK("legacy", sorted_table->encoding == TABLE_SORTED);
+
+  char turns[SOLUTION_SIZE];
+  char ranked_turns[SOLUTION_SIZE];
+  uint32_t seed = TEST_SEED;
+  int i, same = 0;
+  for(i = 0; i < LEGACY_CUBES; i++){
+    int cube = random_cube(&seed);
+    int length = table_solve_cube_into(sorted_table, cube, turns);
+    if(length >= 0 && apply_turns(cube, turns) == SOLVED_CUBE &&
+       length == table_solve_cube_into(table, cube, ranked_turns)){
+      same++;
+    }
+  }
+  CHECK("legacy", same == LEGACY_CUBES);
+  close_state_table(sorted_table);
+}
+
+/** This function tests the batch lookups of a sorted table (see
+  * check_sorted_batch), on a sorted table generated in memory
+  */
+void test_sorted(){
+  unsigned char* state_table = make_state_table();
+  SortedIndex* index = NULL;
+  if(state_table != NULL && fill_state_table(state_table)){
+    index = build_sorted_index(state_table);
+  }
+  int* cubes = (int*) malloc(SORTED_CUBES * sizeof(int));
+  char* turns = (char*) malloc(SORTED_CUBES);
+  char* solutions = (char*) calloc(2 * SORTED_CUBES, SOLUTION_SIZE);
+  if(CHECK("sorted", index != NULL && cubes != NULL && turns != NULL &&
+                     solutions != NULL)){
+    check_sorted_batch(state_table, index, cubes, turns, solutions);
+  }
+  free(state_table);
+  free_sorted_index(index);
+  free(cubes);
+  free(turns);
+  free(solutions);
+}
+
+/** This function checks that the interleaved binary searches
+  * (get_turn_batch), the sorted index and the batch solve, with and without
+  * the index, all agree with get_turn and solve_cube_into.
+  * @param state_table The sorted state table
+  * @param index The index of the table
+  * @param cubes SORTED_CUBES ints, filled with the cubes
+  * @param turns SORTED_CUBES chars, filled with their turns
+  * @param solutions 2 * SORTED_CUBES * SOLUTION_SIZE chars, filled with their
+  *    solutions (without the index, then with it)
+  */
+void check_sorted_batch(const unsigned char* state_table,
+                        const SortedIndex* index, int* cubes, char* turns,
+                        char* solutions){
+  char* indexed_solutions = &solutions[SORTED_CUBES * SOLUTION_SIZE];
+  uint32_t seed = TEST_SEED;
+  int i;
+  for(i = 0; i < SORTED_CUBES; i++) cubes[i] = random_cube(&seed);
+  cubes[0] = SOLVED_CUBE;
+  cubes[1] = 0; //not a cube
+  get_turn_batch(state_table, cubes, SORTED_CUBES, turns);
+
+  int batched = 0, indexed = 0, solved = 0;
+  for(i = 0; i < SORTED_CUBES; i++){
+    char turn = get_turn(state_table, cubes[i]);
+    if(turns[i] == turn) batched++;
+    if(get_indexed_turn(index, cubes[i]) == turn) indexed++;
+  }
+  CHECK("sorted", get_turn(state_table, 0) == -1);
+  CHECK("sorted", batched == SORTED_CUBES);
+  CHECK("sorted", indexed == SORTED_CUBES);
+
+  size_t count = solve_sorted_batch(cubes, SORTED_CUBES, state_table, NULL,
+                                    solutions);
+  size_t indexed_count = solve_sorted_batch(cubes, SORTED_CUBES, state_table,
+                                            index, indexed_solutions);
+  char turn_sequence[SOLUTION_SIZE];
+  for(i = 0; i < SORTED_CUBES; i++){
+    const char* solution = &solutions[i * SOLUTION_SIZE];
+    int length = solve_cube_into(cubes[i], state_table, turn_sequence);
+    if(length == -1 ? solution[0] == -1
+                    : memcmp(solution, turn_sequence, length + 1) == 0){
+      solved++;
+    }
+  }
+  CHECK("sorted", count == SORTED_CUBES - 1 && indexed_count == count);
+  CHECK("sorted", solved == SORTED_CUBES);
+  CHECK("sorted", memcmp(solutions, indexed_solutions,
+                         SORTED_CUBES * SOLUTION_SIZE) == 0);
+}
+
+/** This function tests sessions: following the solution brings the cube
+  * one turn closer to solved, and any other turn solves it again.
+  * @param table The ranked table
+  */
+void test_session(const StateTable* table){
+  SolveSession session;
+  char turns[SOLUTION_SIZE];
+  CHECK("session", start_session(&session, table, 0) == -1);
+  CHECK("session", session_next_turn(&session) == -1);
+
+  uint32_t seed = TEST_SEED;
+  int i, followed = 0, resolved = 0, finished = 0;
+  for(i = 0; i < SESSION_CUBES; i++){
+    int cube = random_cube(&seed);
+    int length = start_session(&session, table, cube);
+    if(length != table_solve_cube_into(table, cube, turns)) continue;
+
+    //a turn off the solution is solved from the new cube
+    int turn = session_next_turn(&session);
+    int other = (turn % 6) + 1;
+    int left = session_turn(&session, other);
+    cube = rotate(cube, other - 1);
+    if(session.cube == cube &&
+       left == table_solve_cube_into(table, cube, turns)){
+      resolved++;
+    }
+
+    //each turn of the solution leaves one turn less
+    left = session_solution(&session, turns);
+    while(left > 0 && session_turn(&session, session_next_turn(&session)) ==
+                      left - 1){
+      left--;
+    }
+    if(left == 0) followed++;
+    if(session.cube == SOLVED_CUBE && session_next_turn(&session) == 0){
+      finished++;
+    }
+  }
+  CHECK("session", resolved == SESSION_CUBES);
+  CHECK("session", followed == SESSION_CUBES);
+  CHECK("session", finished == SESSION_CUBES);
+  CHECK("session", session_turn(&session, 7) == -1);
+}
+
+/** This function tests the variants of the cube (see puzzle.c)
+  * @param table The ranked table, to compare the puzzles with
+  */
+void test_puzzles(const StateTable* table){
+  CHECK("puzzle", find_puzzle("none") == NULL);
+  test_puzzle("qtm", table);
+  test_puzzle("htm", table);
+  test_puzzle("first-layer", table);
+
+  //the <F,U> subgroup solves the cubes its own moves reach, and no other
+  const Puzzle* puzzle = find_puzzle("fu");
+  PuzzleTable* puzzle_table = make_puzzle(puzzle);
+  CHECK("puzzle fu", puzzle_table != NULL);
+  if(puzzle_table == NULL) return;
+  char moves[PUZZLE_SOLUTION_SIZE];
+  uint32_t seed = TEST_SEED;
+  int i, j, solved = 0;
+  for(i = 0; i < PUZZLE_CUBES; i++){
+    int cube = SOLVED_CUBE;
+    for(j = 0; j < WALK_TURNS; j++){
+      cube = rotate(cube, (next_random(&seed) % 2) ? 1 : 5); //F or U
+    }
+    int length = solve_puzzle_cube_into(puzzle_table, cube, moves);
+    if(length >= 0 && length <= WALK_TURNS &&
+       apply_puzzle_moves(puzzle, cube, moves) == SOLVED_CUBE){
+      solved++;
+    }
+  }
+  CHECK("puzzle fu", solved == PUZZLE_CUBES);
+  CHECK("puzzle fu", solve_puzzle_cube_into(puzzle_table,
+                       rotate(SOLVED_CUBE, 3), moves) == -1); //L
+  close_puzzle_table(puzzle_table);
+}
+
+/** This function tests a variant of the cube on random cubes: each
+  * solution brings the pieces of the puzzle to their solved states, and is
+  * no longer than the solution of the ranked table (or as long, for qtm,
+  * which has the same moves and goal).
+  * @param name The name of the puzzle
+  * @param table The ranked table
+  */
+void test_puzzle(const char* name, const StateTable* table){
+  char test[32];
+  snprintf(test, sizeof(test), "puzzle %s", name);
+  const Puzzle* puzzle = find_puzzle(name);
+  PuzzleTable* puzzle_table = (puzzle != NULL) ? make_puzzle(puzzle) : NULL;
+  CHECK(test, puzzle_table != NULL);
+  if(puzzle_table == NULL) return;
+
+  char moves[PUZZLE_SOLUTION_SIZE];
+  char turns[SOLUTION_SIZE];
+  int goal = puzzle_state(puzzle, SOLVED_CUBE);
+  CHECK(test, solve_puzzle_cube_into(puzzle_table, SOLVED_CUBE, moves) == 0);
+
+  uint32_t seed = TEST_SEED;
+  int i, solved = 0, shortest = 0;
+  for(i = 0; i < PUZZLE_CUBES; i++){
+    int cube = random_cube(&seed);
+    int length = solve_puzzle_cube_into(puzzle_table, cube, moves);
+    int quarter_turns = table_solve_cube_into(table, cube, turns);
+    int end = apply_puzzle_moves(puzzle, cube, moves);
+    if(length >= 0 && puzzle_state(puzzle, end) == goal) solved++;
+    if(strcmp(name, "qtm") == 0 ? length == quarter_turns
+                                : length <= quarter_turns){
+      shortest++;
+    }
+  }
+  CHECK(test, solved == PUZZLE_CUBES);
+  CHECK(test, shortest == PUZZLE_CUBES);
+  close_puzzle_table(puzzle_table);
+}
+
+/** This function tests the lock-free MPMC queue of the server: a queue
+  * reports when it is full or empty, and the entries of several producers
+  * are each dequeued exactly once by several consumers.
+  */
+void test_mpmc(){
+  MPMCQueue* queue = createMPMCQueue(4);
+  if(CHECK("mpmc", queue != NULL)){
+    void* entry = NULL;
+    CHECK("mpmc", mpmc_dequeue(queue, &entry) == QUEUE_EMPTY);
+    uintptr_t i;
+    int enqueued = 0;
+    for(i = 1; i <= 4; i++){
+      if(mpmc_enqueue(queue, (void*) i) == QUEUE_OK) enqueued++;
+    }
+    CHECK("mpmc", enqueued == 4);
+    CHECK("mpmc", mpmc_enqueue(queue, (void*) i) == QUEUE_FULL);
+    CHECK("mpmc", mpmc_dequeue(queue, &entry) == QUEUE_OK &&
+                  entry == (void*) 1);
+    deleteMPMCQueue(queue);
+  }
+
+  MPMCTest test = {createMPMCQueue(MPMC_CELLS),
+                   calloc(MPMC_THREADS * MPMC_ITEMS, sizeof(atomic_int)), 0};
+  if(!CHECK("mpmc", test.queue != NULL && test.seen != NULL)){
+    if(test.queue != NULL) deleteMPMCQueue(test.queue);
+    free(test.seen);
+    return;
+  }
+  pthread_t threads[2 * MPMC_THREADS];
+  int t, started = 0;
+  for(t = 0; t < 2 * MPMC_THREADS; t++){
+    if(pthread_create(&threads[t], NULL, t < MPMC_THREADS ? mpmc_producer
+                      : mpmc_consumer, &test) == 0) started++;
+  }
+  if(CHECK("mpmc", started == 2 * MPMC_THREADS)){
+    for(t = 0; t < 2 * MPMC_THREADS; t++) pthread_join(threads[t], NULL);
+    int once = 0;
+    for(t = 0; t < MPMC_THREADS * MPMC_ITEMS; t++){
+      if(atomic_load(&test.seen[t]) == 1) once++;
+    }
+    void* entry;
+    CHECK("mpmc", once == MPMC_THREADS * MPMC_ITEMS);
+    CHECK("mpmc", mpmc_dequeue(test.queue, &entry) == QUEUE_EMPTY);
+  }
+  deleteMPMCQueue(test.queue);
+  free(test.seen);
+}
+
+/** This function tests the batch moves, which use the AVX2 kernels when the
+  * processor has them: every turn of a batch of cubes, or of ranks, gives
+  * what the scalar moves give, including on the cubes after the last whole
+  * pass of a kernel, and the moves on ranks agree with the moves on cubes.
+  */
+void test_batch_moves(){
+  int* cubes = (int*) malloc(3 * BATCH_CUBES * sizeof(int));
+  char* turns = (char*) malloc(BATCH_CUBES);
+  if(!CHECK("moves", cubes != NULL && turns != NULL)){
+    free(cubes);
+    free(turns);
+    return;
+  }
+  int* moved = &cubes[BATCH_CUBES];
+  int* ranks = &cubes[2 * BATCH_CUBES];
+  uint32_t seed = TEST_SEED;
+  int turn, i, batched = 0, ranked = 0, agreed = 0, each = 0;
+  for(turn = 0; turn < 6; turn++){
+    for(i = 0; i < BATCH_CUBES; i++){
+      cubes[i] = random_cube(&seed);
+      moved[i] = cubes[i];
+      ranks[i] = rank_cube(cubes[i]);
+    }
+    rotate_batch(moved, BATCH_CUBES, turn);
+    rotate_rank_batch(ranks, BATCH_CUBES, turn);
+    for(i = 0; i < BATCH_CUBES; i++){
+      if(moved[i] == rotate(cubes[i], turn)) batched++;
+      if(ranks[i] == rotate_rank(rank_cube(cubes[i]), turn)) ranked++;
+      if(ranks[i] == rank_cube(moved[i])) agreed++;
+    }
+  }
+  for(i = 0; i < BATCH_CUBES; i++){
+    turns[i] = next_random(&seed) % 6;
+    ranks[i] = rank_cube(cubes[i]);
+  }
+  rotate_rank_each(ranks, turns, BATCH_CUBES);
+  for(i = 0; i < BATCH_CUBES; i++){
+    if(ranks[i] == rotate_rank(rank_cube(cubes[i]), turns[i])) each++;
+  }
+  CHECK("moves", batched == 6 * BATCH_CUBES);
+  CHECK("moves", ranked == 6 * BATCH_CUBES);
+  CHECK("moves", agreed == 6 * BATCH_CUBES);
+  CHECK("moves", each == BATCH_CUBES);
+  free(cubes);
+  free(turns);
+}
+
+/** This function tests packed cubes: a cube packs and unpacks into itself,
+  * ranks as rank_cube ranks it, and is turned by every turn as rotate turns
+  * it.
+  */
+void test_packed_cubes(){
+  if(!CHECK("packed", init_packed_moves())) return;
+  uint32_t seed = TEST_SEED;
+  int i, turn, unpacked = 0, ranked = 0, turned = 0;
+  for(i = 0; i < PACKED_CUBES; i++){
+    int cube = random_cube(&seed);
+    PackedCube packed = pack_cube(cube);
+    if(unpack_cube(packed) == cube) unpacked++;
+    if(rank_packed(packed) == rank_cube(cube)) ranked++;
+    for(turn = 0; turn < 6; turn++){
+      if(unpack_cube(rotate_packed(packed, turn)) == rotate(cube, turn)){
+        turned++;
+      }
+    }
+  }
+  CHECK("packed", unpacked == PACKED_CUBES);
+  CHECK("packed", ranked == PACKED_CUBES);
+  CHECK("packed", turned == 6 * PACKED_CUBES);
+  CHECK("packed", unpack_cube(pack_cube(SOLVED_CUBE)) == SOLVED_CUBE);
+}
+
+/** This function tests the solution cache: the solution of every cube comes
+  * back from its slot as it went in, a lookup is a miss until the cube is
+  * solved and a hit after, and the batch solve with the cache gives the
+  * solutions of solve_batch, from the table and then from the cache.
+  * @param table The ranked table
+  */
+void test_cache(const StateTable* table){
+  SolutionCache* cache = create_solution_cache(CACHE_CUBES);
+  int* cubes = (int*) malloc(CACHE_CUBES * sizeof(int));
+  char* solutions = (char*) malloc(3 * CACHE_CUBES * SOLUTION_SIZE);
+  if(!CHECK("cache", cache != NULL && cubes != NULL && solutions != NULL)){
+    free_solution_cache(cache);
+    free(cubes);
+    free(solutions);
+    return;
+  }
+  uint32_t seed = TEST_SEED;
+  char turn_sequence[SOLUTION_SIZE];
+  char cached[SOLUTION_SIZE];
+  int i, kept = 0;
+  for(i = 0; i < CACHE_CUBES; i++){
+    cubes[i] = (i == 0) ? SOLVED_CUBE : random_cube(&seed);
+    int rank = rank_cube(cubes[i]);
+    int length = table_solve_cube_into(table, cubes[i], turn_sequence);
+    cache_insert(cache, rank, turn_sequence);
+    if(cache_lookup(cache, rank, cached) == length &&
+       memcmp(cached, turn_sequence, length + 1) == 0) kept++;
+  }
+  CHECK("cache", kept == CACHE_CUBES);
+  free_solution_cache(cache);
+
+  //a cache of the smallest size, so the cubes of the batch share slots
+  cache = create_solution_cache(1);
+  unsigned long long hits, misses;
+  int cube = cubes[1];
+  if(CHECK("cache", cache != NULL)){
+    CHECK("cache", cache_lookup(cache, rank_cube(cube), cached) == -1);
+    int length = cache_solve_cube_into(cache, table, cube, turn_sequence);
+    CHECK("cache", length == table_solve_cube_into(table, cube, cached) &&
+                   memcmp(cached, turn_sequence, length + 1) == 0);
+    CHECK("cache", cache_solve_cube_into(cache, table, cube, cached) ==
+                   length && memcmp(cached, turn_sequence, length + 1) == 0);
+    cache_counts(cache, &hits, &misses);
+    CHECK("cache", hits == 1 && misses == 2);
+    CHECK("cache", cache_solve_cube_into(cache, table, 0, cached) == -1);
+
+    cubes[2] = 0; //not a cube
+    char* cache_solutions = &solutions[CACHE_CUBES * SOLUTION_SIZE];
+    char* again = &solutions[2 * CACHE_CUBES * SOLUTION_SIZE];
+    size_t solved = solve_batch(cubes, CACHE_CUBES, table, solutions);
+    CHECK("cache", cache_solve_batch(cache, cubes, CACHE_CUBES, table,
+                                     cache_solutions) == solved);
+    CHECK("cache", cache_solve_batch(cache, cubes, CACHE_CUBES, table,
+                                     again) == solved);
+    int same = 0;
+    for(i = 0; i < CACHE_CUBES; i++){
+      //a hit fills the turns up to the terminator, not the whole solution
+      const char* solution = &solutions[i * SOLUTION_SIZE];
+      if(strcmp(&cache_solutions[i * SOLUTION_SIZE], solution) == 0 &&
+         strcmp(&again[i * SOLUTION_SIZE], solution) == 0) same++;
+    }
+    CHECK("cache", same == CACHE_CUBES);
+    cache_counts(cache, &hits, &misses);
+    CHECK("cache", hits > 1 && hits + misses == 3 + (2 * (CACHE_CUBES - 1)));
+  }
+  free_solution_cache(cache);
+  free(cubes);
+  free(solutions);
+}
+
+/** This function tests packed solutions: the solution of every cube packs
+  * and unpacks into itself, the packed batch solve gives the packed
+  * solutions of solve_batch, and a packed solution is written in the
+  * standard notation.
+  * @param table The ranked table
+  */
+void test_packed_solutions(const StateTable* table){
+  int* cubes = (int*) malloc(PACKED_SOLUTIONS * sizeof(int));
+  char* solutions = (char*) malloc(PACKED_SOLUTIONS * SOLUTION_SIZE);
+  PackedSolution* packed = (PackedSolution*) malloc(PACKED_SOLUTIONS *
+                                                    sizeof(PackedSolution));
+  if(!CHECK("solutions", cubes != NULL && solutions != NULL &&
+                         packed != NULL)){
+    free(cubes);
+    free(solutions);
+    free(packed);
+    return;
+  }
+  uint32_t seed = TEST_SEED;
+  char turn_sequence[SOLUTION_SIZE];
+  int i, unpacked = 0, batched = 0;
+  for(i = 0; i < PACKED_SOLUTIONS; i++){
+    cubes[i] = (i == 0) ? SOLVED_CUBE : random_cube(&seed);
+  }
+  cubes[1] = 0; //not a cube
+  size_t solved = solve_batch(cubes, PACKED_SOLUTIONS, table, solutions);
+  CHECK("solutions", solve_batch_packed(cubes, PACKED_SOLUTIONS, table,
+                                        packed) == solved);
+  for(i = 0; i < PACKED_SOLUTIONS; i++){
+    const char* solution = &solutions[i * SOLUTION_SIZE];
+    PackedSolution repacked = pack_solution(solution);
+    int length = unpack_solution(repacked, turn_sequence);
+    if(length == -1 ? solution[0] == -1 && turn_sequence[0] == -1
+                    : memcmp(turn_sequence, solution, length + 1) == 0 &&
+                      solution_length(repacked) == length) unpacked++;
+    if(packed[i] == repacked) batched++;
+  }
+  CHECK("solutions", unpacked == PACKED_SOLUTIONS);
+  CHECK("solutions", batched == PACKED_SOLUTIONS);
+  CHECK("solutions", packed[0] == 0 && packed[1] == PACKED_SOLUTION_INVALID);
+
+  //the longest solution packs, a longer one does not
+  const char longest[] = {1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6, 1, 2, 0};
+  const char too_long[] = {1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6, 1, 2, 3, 0};
+  PackedSolution solution = pack_solution(longest);
+  CHECK("solutions", unpack_solution(solution, turn_sequence) == 14 &&
+                     memcmp(turn_sequence, longest, sizeof(longest)) == 0);
+  CHECK("solutions", solution_turn(solution, 13) == 2);
+  CHECK("solutions", pack_solution(too_long) == PACKED_SOLUTION_INVALID);
+
+  char line[OUTPUT_LINE_SIZE];
+  const char turns[] = {1, 2, 3, 4, 5, 6, 0};
+  *format_packed_solution(line, pack_solution(turns)) = 0;
+  CHECK("solutions", strcmp(line, "F' F L' L U' U\n") == 0);
+  *format_packed_solution(line, 0) = 0;
+  CHECK("solutions", strcmp(line, "\n") == 0);
+  *format_packed_solution(line, PACKED_SOLUTION_INVALID) = 0;
+  CHECK("solutions", strcmp(line, "INVALID\n") == 0);
+  free(cubes);
+  free(solutions);
+  free(packed);
+}
+
+/** This function tests the mod 3 table: reduced from the depth table, it
+  * holds each depth modulo 3, solves as short as the ranked table, directly
+  * and decoded into a ranked table, and a cube left unknown is reported as
+  * corrupt.
+  * @param table The ranked table
+  */
+void test_mod3(const StateTable* table){
+  uint8_t* depth_table = make_depth_table();
+  uint8_t* mod3_table = make_mod3_table();
+  uint64_t* decoded = make_ranked_table();
+  if(!CHECK("mod3", depth_table != NULL && mod3_table != NULL &&
+                    decoded != NULL &&
+                    generate_depth_table(depth_table) &&
+                    reduce_depth_table(depth_table, mod3_table) &&
+                    decode_mod3_table(mod3_table, decoded))){
+    free(depth_table);
+    free(mod3_table);
+    free(decoded);
+    return;
+  }
+  StateTable decoded_table = {TABLE_RANKED, decoded,
+                              RANKED_TABLE_WORDS * sizeof(uint64_t), NULL, 0,
+                              NULL};
+  uint32_t seed = TEST_SEED;
+  char turn_sequence[SOLUTION_SIZE];
+  int i, depths = 0, solved = 0, decoded_solved = 0;
+  for(i = 0; i < MOD3_CUBES; i++){
+    int cube = (i == 0) ? SOLVED_CUBE : random_cube(&seed);
+    int rank = rank_cube(cube);
+    int length = table_solve_cube_into(table, cube, turn_sequence);
+    if(depth_at(depth_table, rank) == length &&
+       mod3_at(mod3_table, rank) == length % 3) depths++;
+    if(solve_mod3_cube_into(cube, mod3_table, turn_sequence) == length &&
+       apply_turns(cube, turn_sequence) == SOLVED_CUBE) solved++;
+    if(table_solve_cube_into(&decoded_table, cube, turn_sequence) ==
+       length && apply_turns(cube, turn_sequence) == SOLVED_CUBE){
+      decoded_solved++;
+    }
+  }
+  CHECK("mod3", depths == MOD3_CUBES);
+  CHECK("mod3", solved == MOD3_CUBES);
+  CHECK("mod3", decoded_solved == MOD3_CUBES);
+  CHECK("mod3", solve_mod3_cube_into(0, mod3_table, turn_sequence) == -1);
+
+  //a table with one cube left unknown
+  int cube = random_cube(&seed);
+  int rank = rank_cube(cube);
+  mod3_table[rank / 4] |= UNKNOWN_MOD3 << ((rank % 4) * 2);
+  CHECK("mod3", get_mod3_turn(mod3_table, cube) == -1);
+  CHECK("mod3", !decode_mod3_table(mod3_table, decoded));
+  free(depth_table);
+  free(mod3_table);
+  free(decoded);
+}
+
+/** This function tests the lazy table, kept in memory only: it solves
+  * optimally while the ranked table is generated in the background, and once
+  * the table is published it gives the solutions of the ranked table.
+  * @param table The ranked table
+  */
+void test_lazy(const StateTable* table){
+  StateTable* lazy = open_lazy_table(NULL);
+  int* cubes = (int*) malloc(LAZY_CUBES * sizeof(int));
+  char* solutions = (char*) malloc(2 * LAZY_CUBES * SOLUTION_SIZE);
+  if(CHECK("lazy", lazy != NULL && cubes != NULL && solutions != NULL)){
+    const LazyTable* lazy_table = (const LazyTable*) lazy->data;
+    uint32_t seed = TEST_SEED;
+    int i;
+    for(i = 0; i < LAZY_CUBES; i++) cubes[i] = random_cube(&seed);
+    cubes[1] = 0; //not a cube
+    //by search, unless the table was generated first
+    CHECK("lazy", check_lazy_batch(lazy, table, cubes, solutions) ==
+                  LAZY_CUBES);
+    int waited;
+    for(waited = 0; !lazy_table_ready(lazy_table) && waited < LAZY_WAIT_MS;
+        waited += 10){
+      struct timespec pause = {0, 10000000};
+      nanosleep(&pause, NULL);
+    }
+    if(CHECK("lazy", lazy_table_ready(lazy_table))){
+      CHECK("lazy", check_lazy_batch(lazy, table, cubes, solutions) ==
+                    LAZY_CUBES);
+      CHECK("lazy", memcmp(solutions, &solutions[LAZY_CUBES * SOLUTION_SIZE],
+                           LAZY_CUBES * SOLUTION_SIZE) == 0);
+    }
+  }
+  if(lazy != NULL) close_lazy_table(lazy);
+  free(cubes);
+  free(solutions);
+}
+
+/** This function solves a batch of cubes with a lazy table, one at a time
+  * and together, and counts the cubes solved as short as the ranked table
+  * solves them (or invalid for both)
+  * @param lazy The lazy table
+  * @param table The ranked table
+  * @param cubes LAZY_CUBES cubes
+  * @param solutions 2 * LAZY_CUBES * SOLUTION_SIZE chars, filled with the
+  *    solutions of the lazy batch solve, then of the ranked one
+  * @return The number of cubes solved alike
+  */
+int check_lazy_batch(const StateTable* lazy, const StateTable* table,
+                     const int* cubes, char* solutions){
+  char* ranked_solutions = &solutions[LAZY_CUBES * SOLUTION_SIZE];
+  solve_batch(cubes, LAZY_CUBES, lazy, solutions);
+  solve_batch(cubes, LAZY_CUBES, table, ranked_solutions);
+  char turn_sequence[SOLUTION_SIZE];
+  int i, alike = 0;
+  for(i = 0; i < LAZY_CUBES; i++){
+    const char* solution = &solutions[i * SOLUTION_SIZE];
+    int length = table_solve_cube_into(table, cubes[i], turn_sequence);
+    int one = table_solve_cube_into(lazy, cubes[i], turn_sequence);
+    if(length == -1 ? one == -1 && solution[0] == -1
+                    : one == length && (int) strlen(solution) == length &&
+                      apply_turns(cubes[i], solution) == SOLVED_CUBE){
+      alike++;
+    }
+  }
+  return alike;
+}
+
+/** This function tests the growable Queue64: entries added one at a time and
+  * n at a time across several segments come out in order, in any mix of
+  * single and bulk removes, the emptied segments are kept, and a limited
+  * queue refuses the entries it has no room for.
+  */
+void test_queue64(){
+  Queue64* queue = createQueue64(0);
+  uint64_t* entries = (uint64_t*) malloc(QUEUE64_ENTRIES * sizeof(uint64_t));
+  if(!CHECK("queue64", queue != NULL && entries != NULL)){
+    if(queue != NULL) deleteQueue64(queue);
+    free(entries);
+    return;
+  }
+  size_t i;
+  int added = 1;
+  for(i = 0; i < QUEUE64_ENTRIES; i++) entries[i] = QUEUE_VALUE(i);
+  for(i = 0; i < QUEUE64_SEGMENT + 3; i++){
+    if(enqueue64(queue, entries[i]) != QUEUE_OK) added = 0;
+  }
+  while(i < QUEUE64_ENTRIES){
+    size_t n = (QUEUE64_ENTRIES - i < 1000) ? QUEUE64_ENTRIES - i : 1000;
+    if(enqueue64_n(queue, &entries[i], n) != QUEUE_OK) added = 0;
+    i += n;
+  }
+  CHECK("queue64", added && queue->cells_used == QUEUE64_ENTRIES);
+
+  //take the entries out one, then 777, at a time
+  size_t taken = 0, in_order = 0;
+  uint64_t removed[777];
+  while(taken < QUEUE64_ENTRIES){
+    uint64_t entry;
+    if(dequeue64(queue, &entry) != QUEUE_OK) break;
+    if(entry == entries[taken++]) in_order++;
+    size_t n = dequeue64_n(queue, removed, 777);
+    for(i = 0; i < n; i++){
+      if(removed[i] == entries[taken++]) in_order++;
+    }
+  }
+  uint64_t entry;
+  CHECK("queue64", taken == QUEUE64_ENTRIES && in_order == QUEUE64_ENTRIES);
+  CHECK("queue64", dequeue64(queue, &entry) == QUEUE_EMPTY &&
+                   dequeue64_n(queue, removed, 777) == 0);
+  CHECK("queue64", queue->spare != NULL);
+
+  //two in and one out, so the head follows the tail across the segments
+  size_t next_in = 0, next_out = 0;
+  in_order = 0;
+  while(next_in + 2 <= QUEUE64_ENTRIES){
+    enqueue64(queue, entries[next_in++]);
+    enqueue64(queue, entries[next_in++]);
+    if(dequeue64(queue, &entry) == QUEUE_OK && entry == entries[next_out++]){
+      in_order++;
+    }
+  }
+  while(dequeue64(queue, &entry) == QUEUE_OK){
+    if(entry == entries[next_out++]) in_order++;
+  }
+  CHECK("queue64", next_out == next_in && in_order == next_in);
+  deleteQueue64(queue);
+
+  queue = createQueue64(10);
+  if(CHECK("queue64", queue != NULL)){
+    CHECK("queue64", enqueue64_n(queue, entries, 11) == QUEUE_FULL &&
+                     queue->cells_used == 0);
+    CHECK("queue64", enqueue64_n(queue, entries, 10) == QUEUE_OK);
+    CHECK("queue64", enqueue64(queue, entries[10]) == QUEUE_FULL);
+    clearQueue64(queue);
+    CHECK("queue64", dequeue64(queue, &entry) == QUEUE_EMPTY);
+    deleteQueue64(queue);
+  }
+  free(entries);
+}
+
+/** This function tests the SPSC queue: it holds as many entries as it was
+  * rounded up to, and every entry a producer thread adds, n at a time, comes
+  * out in order in the consumer.
+  */
+void test_spsc(){
+  SPSCQueue64* queue = createSPSCQueue64(SPSC_CELLS);
+  if(!CHECK("spsc", queue != NULL)) return;
+  uint64_t entries[2 * SPSC_CELLS];
+  size_t i;
+  for(i = 0; i < 2 * SPSC_CELLS; i++) entries[i] = QUEUE_VALUE(i);
+  CHECK("spsc", spsc_enqueue64_n(queue, entries, 2 * SPSC_CELLS) == 1024);
+  CHECK("spsc", spsc_enqueue64(queue, entries[0]) == QUEUE_FULL);
+  uint64_t entry;
+  size_t taken = spsc_dequeue64_n(queue, entries, 2 * SPSC_CELLS);
+  CHECK("spsc", taken == 1024 && entries[1023] == QUEUE_VALUE(1023));
+  CHECK("spsc", spsc_dequeue64(queue, &entry) == QUEUE_EMPTY);
+
+  pthread_t producer;
+  if(!CHECK("spsc", pthread_create(&producer, NULL, spsc_producer,
+                                   queue) == 0)){
+    deleteSPSCQueue64(queue);
+    return;
+  }
+  size_t in_order = 0;
+  taken = 0;
+  while(taken < SPSC_ENTRIES){
+    size_t n = spsc_dequeue64_n(queue, entries, 100);
+    if(n == 0) sched_yield();
+    for(i = 0; i < n; i++){
+      if(entries[i] == QUEUE_VALUE(taken++)) in_order++;
+    }
+  }
+  pthread_join(producer, NULL);
+  CHECK("spsc", in_order == SPSC_ENTRIES);
+  CHECK("spsc", spsc_dequeue64(queue, &entry) == QUEUE_EMPTY);
+  deleteSPSCQueue64(queue);
+}
+
+/** This function tests the scrambler: each scramble turns the solved cube
+  * into its cube in as many turns as the ranked table needs to solve it, a
+  * depth filter only gives cubes at that depth, every cube is at one of the
+  * depths, and the same seed gives the same scrambles.
+  * @param table The ranked table
+  */
+void test_scramble(const StateTable* table){
+  Scrambler* scrambler = create_scrambler(table, TEST_SEED);
+  Scrambler* again = create_scrambler(table, TEST_SEED);
+  int* cubes = (int*) malloc(2 * SCRAMBLE_CUBES * sizeof(int));
+  char* scrambles = (char*) malloc(2 * SCRAMBLE_CUBES * SOLUTION_SIZE);
+  if(!CHECK("scramble", scrambler != NULL && again != NULL &&
+                        cubes != NULL && scrambles != NULL)){
+    free_scrambler(scrambler);
+    free_scrambler(again);
+    free(cubes);
+    free(scrambles);
+    return;
+  }
+  //the same seed gives the same cubes and scrambles
+  scramble_batch(scrambler, SCRAMBLE_ANY_DEPTH, cubes, scrambles,
+                 SCRAMBLE_CUBES);
+  scramble_batch(again, SCRAMBLE_ANY_DEPTH, &cubes[SCRAMBLE_CUBES],
+                 &scrambles[SCRAMBLE_CUBES * SOLUTION_SIZE], SCRAMBLE_CUBES);
+  CHECK("scramble", memcmp(cubes, &cubes[SCRAMBLE_CUBES],
+                           SCRAMBLE_CUBES * sizeof(int)) == 0);
+  CHECK("scramble", memcmp(scrambles, &scrambles[SCRAMBLE_CUBES *
+                           SOLUTION_SIZE], SCRAMBLE_CUBES * SOLUTION_SIZE) ==
+                    0);
+
+  char turn_sequence[SOLUTION_SIZE];
+  int depth, i, scrambled = 0, sampled = 0, expected = 0;
+  size_t listed = 0;
+  for(depth = SCRAMBLE_ANY_DEPTH; depth < SOLUTION_SIZE; depth++){
+    size_t n = scramble_batch(scrambler, depth, cubes, scrambles,
+                              SCRAMBLE_CUBES);
+    if(depth != SCRAMBLE_ANY_DEPTH){
+      listed += scrambler->depth_counts[depth];
+      if(scrambler->depth_counts[depth] == 0){
+        if(n == 0) sampled++;
+        continue;
+      }
+    }
+    if(n == SCRAMBLE_CUBES) sampled++;
+    for(i = 0; i < (int) n; i++){
+      const char* scramble = &scrambles[i * SOLUTION_SIZE];
+      int length = table_solve_cube_into(table, cubes[i], turn_sequence);
+      if(apply_turns(SOLVED_CUBE, scramble) == cubes[i] &&
+         (int) strlen(scramble) == length &&
+         (depth == SCRAMBLE_ANY_DEPTH || length == depth)) scrambled++;
+      expected++;
+    }
+  }
+  CHECK("scramble", sampled == SOLUTION_SIZE + 1);
+  CHECK("scramble", scrambled == expected);
+  CHECK("scramble", listed == NUMBER_OF_CUBES);
+  CHECK("scramble", scrambler->depth_counts[0] == 1);
+  CHECK("scramble", scramble_batch(scrambler, SOLUTION_SIZE, cubes,
+                                   scrambles, 1) == 0);
+  free_scrambler(scrambler);
+  free_scrambler(again);
+  free(cubes);
+  free(scrambles);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function counts a check, and reports it when it failed
+  * @param test The name of the test
+  * @param condition The result of the check
+  * @param what The text of the check
+  * @return The result of the check
+  */
+int check(const char* test, int condition, const char* what){
+  if(condition){
+    passed++;
+  }else{
+    failed++;
+    printf("FAIL %s %s\n", test, what);
+  }
+  return condition;
+}
+
+/** This function enqueues the entries of one producer of test_mpmc: the
+  * numbers of its entries, plus 1 so that none is NULL
+  * @param argument The MPMCTest
+  * @return NULL
+  */
+void* mpmc_producer(void* argument){
+  MPMCTest* test = (MPMCTest*) argument;
+  uintptr_t first = (uintptr_t) atomic_fetch_add(&test->producer, 1) *
+                    MPMC_ITEMS;
+  uintptr_t i;
+  for(i = first; i < first + MPMC_ITEMS; i++){
+    while(mpmc_enqueue(test->queue, (void*) (i + 1)) != QUEUE_OK){
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/** This function dequeues MPMC_ITEMS entries for test_mpmc, counting each
+  * @param argument The MPMCTest
+  * @return NULL
+  */
+void* mpmc_consumer(void* argument){
+  MPMCTest* test = (MPMCTest*) argument;
+  int taken = 0;
+  while(taken < MPMC_ITEMS){
+    void* entry;
+    if(mpmc_dequeue(test->queue, &entry) != QUEUE_OK){
+      sched_yield();
+      continue;
+    }
+    uintptr_t i = (uintptr_t) entry - 1;
+    if(i < MPMC_THREADS * MPMC_ITEMS) atomic_fetch_add(&test->seen[i], 1);
+    taken++;
+  }
+  return NULL;
+}
+
+/** This function adds the entries of test_spsc, up to 100 at a time, as
+  * the queue has room for them
+  * @param argument The SPSCQueue64
+  * @return NULL
+  */
+void* spsc_producer(void* argument){
+  SPSCQueue64* queue = (SPSCQueue64*) argument;
+  uint64_t entries[100];
+  size_t next = 0;
+  while(next < SPSC_ENTRIES){
+    size_t n = (SPSC_ENTRIES - next < 100) ? SPSC_ENTRIES - next : 100;
+    size_t i;
+    for(i = 0; i < n; i++) entries[i] = QUEUE_VALUE(next + i);
+    size_t added = spsc_enqueue64_n(queue, entries, n);
+    if(added == 0) sched_yield();
+    next += added;
+  }
+  return NULL;
+}
+
+/** This function returns the next number of a xorshift random sequence
+  * @param state The state of the sequence (never 0)
+  * @return The next number
+  */
+uint32_t next_random(uint32_t* state){
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/** This function returns a cube chosen uniformly at random
+  * @param state The state of the random sequence
+  * @return The integer representation of the cube
+  */
+int random_cube(uint32_t* state){
+  return unrank_cube(next_random(state) % NUMBER_OF_CUBES);
+}
+
+/** This function writes the colors of a cube in the order the solver asks
+  * for them (see print_intro in solver.c): the top, left, front, right, back
+  * and bottom faces, each row by row.
+  * @param cube The integer representation of the cube
+  * @param colors BUFF_SIZE chars, filled with the colors
+  */
+void cube_colors(int cube, char* colors){
+  Cube my_cube;
+  decompress_into(cube, &my_cube);
+  int i;
+  for(i = 0; i < 4; i++){
+    colors[i] = my_cube.cube[i / 2][2 + (i % 2)];
+    colors[20 + i] = my_cube.cube[4 + (i / 2)][2 + (i % 2)];
+  }
+  for(i = 0; i < 16; i++){
+    int face = i / 4;
+    colors[4 + i] = my_cube.cube[2 + ((i % 4) / 2)][(face * 2) + (i % 2)];
+  }
+}
+
+/** This function makes the turns of a solution on a cube
+  * @param cube The integer representation of the cube
+  * @param turns The turns, followed by 0 (see the turn codes in cube.h)
+  * @return The turned cube
+  */
+int apply_turns(int cube, const char* turns){
+  for(; *turns != 0; turns++) cube = rotate(cube, *turns - 1);
+  return cube;
+}
+
+/** This function makes the moves of a puzzle solution on a cube
+  * @param puzzle The puzzle
+  * @param cube The integer representation of the cube
+  * @param moves The moves (the move index + 1), followed by 0
+  * @return The moved cube
+  */
+int apply_puzzle_moves(const Puzzle* puzzle, int cube, const char* moves){
+  for(; *moves != 0; moves++){
+    const PuzzleMove* move = &puzzle->moves[*moves - 1];
+    int times;
+    for(times = 0; times < move->times; times++){
+      cube = rotate(cube, move->rotation);
+    }
+  }
+  return cube;
+}
+
+/** This function generates the table of a puzzle in memory (unlike
+  * load_puzzle_table, which saves it)
+  * @param puzzle The puzzle
+  * @return Pointer to the table
+  * @return NULL Out of memory
+  */
+PuzzleTable* make_puzzle(const Puzzle* puzzle){
+  PuzzleTable* table = (PuzzleTable*) calloc(1, sizeof(PuzzleTable));
+  if(table == NULL) return NULL;
+  table->puzzle = puzzle;
+  table->generated = make_puzzle_table(puzzle);
+  if(table->generated == NULL ||
+     !generate_puzzle_table(puzzle, table->generated, 1)){
+    close_puzzle_table(table);
+    return NULL;
+  }
+  table->entries = table->generated + PUZZLE_NAME_WORDS;
+  return table;
+}
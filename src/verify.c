@@ -0,0 +1,239 @@
+/** File: verify.c
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the verification of a state table against every cube.
+  *
+  * The ranks 0 - 3,674,159 are cut into one slice per thread, and each
+  * thread turns its ranks back into cubes and solves them with the table a
+  * batch at a time (see solve_batch), so no list of cubes is built. Every
+  * solution is replayed on rank coordinates with the move tables and must
+  * end on the solved cube, and its length must be the depth of the cube in
+  * a depth table generated for the check (see depth_table.c). The threads
+  * count their cubes on their own and the counts are added up at the end.
+  */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~ Include Files and Define Constants ~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "verify.h"
+#include "depth_table.h"
+#include "cube.h"
+
+#define VERIFY_BATCH 1024 //cubes solved per call to solve_batch
+
+//the ranks checked by one thread
+typedef struct VerifySlice {
+  const StateTable* table;
+  const uint8_t* depth_table;
+  int start;                    //first rank of the slice
+  int end;                      //one past the last rank of the slice
+  int solved_rank;              //the rank of the solved cube
+  VerifyReport report;          //the counts of this slice
+} VerifySlice;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~ Helper Function Prototypes ~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+void* verify_slice(void* arg);
+void check_solution(const VerifySlice* slice, VerifyReport* report, int rank,
+                    int cube, const char* solution);
+void add_sample(VerifyReport* report, int cube);
+void merge_report(VerifyReport* report, const VerifyReport* slice_report);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~ Verify Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function checks the solution a table gives for every cube: it must
+  * solve the cube, and be a shortest solution.
+  * @param table The loaded table (of any encoding)
+  * @param threads The number of threads to use
+  * @param report Filled with the counts and the first failing cubes
+  * @return 1 Every cube has a shortest solution
+  * @return 0 Some cubes do not
+  * @return -1 The check could not run (out of memory)
+  */
+int verify_table(const StateTable* table, int threads, VerifyReport* report){
+  if(threads < 1) threads = 1;
+  memset(report, 0, sizeof(VerifyReport));
+  report->threads = threads;
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  uint8_t* depth_table = make_depth_table();
+  VerifySlice* slices = (VerifySlice*) calloc(threads, sizeof(VerifySlice));
+  pthread_t* thread_ids = (pthread_t*) malloc(threads * sizeof(pthread_t));
+  if(depth_table == NULL || slices == NULL || thread_ids == NULL ||
+     !generate_depth_table(depth_table)){
+    free(depth_table);
+    free(slices);
+    free(thread_ids);
+    return -1;
+  }
+
+  int solved_rank = rank_cube(SOLVED_CUBE);
+  int i;
+  for(i = 0; i < threads; i++){
+    slices[i].solved_rank = solved_rank;
+    slices[i].table = table;
+    slices[i].depth_table = depth_table;
+    slices[i].start = (int) (((long long) NUMBER_OF_CUBES * i) / threads);
+    slices[i].end = (int) (((long long) NUMBER_OF_CUBES * (i + 1)) / threads);
+  }
+
+  //the calling thread takes the first slice, and any slice whose thread
+  //could not be started
+  int* started = (int*) calloc(threads, sizeof(int));
+  for(i = 1; i < threads && started != NULL; i++){
+    started[i] = pthread_create(&thread_ids[i], NULL, verify_slice,
+                                &slices[i]) == 0;
+  }
+  for(i = 0; i < threads; i++){
+    if(i == 0 || started == NULL || !started[i]) verify_slice(&slices[i]);
+  }
+  for(i = 0; i < threads; i++){
+    if(i > 0 && started != NULL && started[i]){
+      pthread_join(thread_ids[i], NULL);
+    }
+    merge_report(report, &slices[i].report);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  report->seconds = (end.tv_sec - start.tv_sec) +
+                    ((end.tv_nsec - start.tv_nsec) / 1e9);
+  free(started);
+  free(depth_table);
+  free(slices);
+  free(thread_ids);
+  return report->invalid + report->unsolved + report->not_optimal == 0 &&
+         report->cubes == NUMBER_OF_CUBES;
+}
+
+/** This function writes a verification report, one VERIFY line each for the
+  * totals, each depth, the failures and each failing cube kept, followed by
+  * VERIFY PASS or VERIFY FAIL.
+  * @param out The stream to write to
+  * @param report The report
+  */
+void print_verify_report(FILE* out, const VerifyReport* report){
+  fprintf(out, "VERIFY cubes=%zu threads=%d seconds=%.3f cubes_per_s=%.0f\n",
+          report->cubes, report->threads, report->seconds,
+          report->seconds > 0 ? report->cubes / report->seconds : 0.0);
+  int depth;
+  for(depth = 0; depth < SOLUTION_SIZE; depth++){
+    if(report->depth_counts[depth] == 0) continue;
+    fprintf(out, "VERIFY depth=%d cubes=%zu\n", depth,
+            report->depth_counts[depth]);
+  }
+  fprintf(out, "VERIFY invalid=%zu unsolved=%zu not_optimal=%zu\n",
+          report->invalid, report->unsolved, report->not_optimal);
+  int i;
+  for(i = 0; i < report->sample_count; i++){
+    fprintf(out, "VERIFY failed_cube=%d\n", report->samples[i]);
+  }
+  int passed = report->invalid + report->unsolved + report->not_optimal == 0 &&
+               report->cubes == NUMBER_OF_CUBES;
+  fprintf(out, "VERIFY %s\n", passed ? "PASS" : "FAIL");
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~ Local Helper Functions ~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+/** This function checks every cube of a slice, a batch at a time. The counts
+  * are kept on the stack of the thread until the end, so threads do not
+  * write to the same cache lines.
+  * @param arg The VerifySlice
+  * @return NULL
+  */
+void* verify_slice(void* arg){
+  VerifySlice* slice = (VerifySlice*) arg;
+  VerifyReport report;
+  memset(&report, 0, sizeof(VerifyReport));
+  int cubes[VERIFY_BATCH];
+  char solutions[VERIFY_BATCH * SOLUTION_SIZE];
+
+  int rank;
+  for(rank = slice->start; rank < slice->end; rank += VERIFY_BATCH){
+    int n = (slice->end - rank < VERIFY_BATCH) ? slice->end - rank
+                                               : VERIFY_BATCH;
+    int i;
+    for(i = 0; i < n; i++) cubes[i] = unrank_cube(rank + i);
+    solve_batch(cubes, n, slice->table, solutions);
+    for(i = 0; i < n; i++){
+      check_solution(slice, &report, rank + i, cubes[i],
+                     &solutions[i * SOLUTION_SIZE]);
+    }
+  }
+  slice->report = report;
+  return NULL;
+}
+
+/** This function replays the solution of one cube and counts the result
+  * @param slice The slice the cube is in
+  * @param report The counts of the slice
+  * @param rank The rank of the cube
+  * @param cube The cube
+  * @param solution Its solution, as filled by solve_batch
+  */
+void check_solution(const VerifySlice* slice, VerifyReport* report, int rank,
+                    int cube, const char* solution){
+  int depth = depth_at(slice->depth_table, rank);
+  report->cubes++;
+  report->depth_counts[depth]++;
+  if(solution[0] == -1){
+    report->invalid++;
+    add_sample(report, cube);
+    return;
+  }
+
+  int length = 0;
+  int at = rank;
+  while(length < SOLUTION_SIZE - 1 && solution[length] != 0){
+    int turn = solution[length];
+    if(turn < 1 || turn > 6) break; //not a turn
+    at = rotate_rank(at, turn - 1);
+    length++;
+  }
+  if(at != slice->solved_rank || solution[length] != 0){
+    report->unsolved++;
+    add_sample(report, cube);
+  }else if(length != depth){
+    report->not_optimal++;
+    add_sample(report, cube);
+  }
+}
+
+/** This function keeps a failing cube for the report, if there is room
+  * @param report The report
+  * @param cube The cube
+  */
+void add_sample(VerifyReport* report, int cube){
+  if(report->sample_count < VERIFY_SAMPLES){
+    report->samples[report->sample_count++] = cube;
+  }
+}
+
+/** This function adds the counts of a slice to a report
+  * @param report The report of every slice
+  * @param slice_report The report of one slice
+  */
+void merge_report(VerifyReport* report, const VerifyReport* slice_report){
+  report->cubes += slice_report->cubes;
+  int depth;
+  for(depth = 0; depth < SOLUTION_SIZE; depth++){
+    report->depth_counts[depth] += slice_report->depth_counts[depth];
+  }
+  report->invalid += slice_report->invalid;
+  report->unsolved += slice_report->unsolved;
+  report->not_optimal += slice_report->not_optimal;
+  int i;
+  for(i = 0; i < slice_report->sample_count; i++){
+    add_sample(report, slice_report->samples[i]);
+  }
+}
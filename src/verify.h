@@ -0,0 +1,37 @@
+/** File: verify.h
+  * @author Jeff Martin
+  * @date 10/14/2026
+  * This file contains the report structure and the function prototypes for
+  * the file verify.c
+  */
+
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "table_file.h"
+#include "state_table.h"
+
+#define VERIFY_SAMPLES 8 //failing cubes kept for the report
+
+//the result of checking every cube against a table
+typedef struct VerifyReport {
+  size_t cubes;                         //cubes checked
+  size_t depth_counts[SOLUTION_SIZE];   //cubes with a shortest solution of
+                                        //each length
+  size_t invalid;                       //cubes the table could not solve
+  size_t unsolved;                      //the turns do not solve the cube
+  size_t not_optimal;                   //the turns solve the cube, but
+                                        //there is a shorter solution
+  int samples[VERIFY_SAMPLES];          //the first failing cubes
+  int sample_count;
+  int threads;
+  double seconds;
+} VerifyReport;
+
+//Function Prototypes
+int verify_table(const StateTable* table, int threads, VerifyReport* report);
+void print_verify_report(FILE* out, const VerifyReport* report);
+
+#endif